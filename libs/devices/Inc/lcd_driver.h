@@ -13,6 +13,13 @@
 #define LCD_DRIVER_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+/** * @name Geometría Máxima del Framebuffer
+ * @{ */
+#define LCD_FB_MAX_ROWS   4U   /**< Filas del modelo más grande soportado (20x4). */
+#define LCD_FB_MAX_COLS   20U  /**< Columnas del modelo más grande soportado (20x4). */
+/** @} */
 
 /** * @name Tipos de Geometría
  * @{ */
@@ -41,11 +48,15 @@ typedef enum {
 
 /**
  * @brief Estructura de configuración del hardware LCD.
+ * @details Con el pin R/W conectado, el driver consulta el Busy Flag (D7) y cada byte
+ * tarda lo que el controlador necesita (~40µs). Sin R/W (port_rw = NULL) se usa el
+ * perfil de retardos fijos validado con analizador lógico (~2.8ms por byte).
  * @note Los puertos deben pasarse como direcciones de memoria del periférico (ej. &PORTB).
  */
 typedef struct {
     volatile uint8_t* port_rs; uint8_t pin_rs; /**< Register Select: Low=Instrucción, High=Dato */
     volatile uint8_t* port_en; uint8_t pin_en; /**< Enable: Disparo por flanco descendente */
+    volatile uint8_t* port_rw; uint8_t pin_rw; /**< Read/Write (opcional): NULL = R/W a GND y retardos fijos */
     volatile uint8_t* port_d4; uint8_t pin_d4; /**< Pin de datos Bus D4 */
     volatile uint8_t* port_d5; uint8_t pin_d5; /**< Pin de datos Bus D5 */
     volatile uint8_t* port_d6; uint8_t pin_d6; /**< Pin de datos Bus D6 */
@@ -53,16 +64,32 @@ typedef struct {
     lcd_type_t   type;                         /**< Modelo del display para gestión de DDRAM */
 } LCD_Config_t;
 
+/**
+ * @brief Consultas al Busy Flag antes de declarar un timeout (~5µs cada una, ~10ms en total).
+ * @details Si el flag no se libera (R/W sin conectar o a GND), el driver pasa de forma
+ * permanente al perfil de retardos fijos.
+ */
+#ifndef LCD_BUSY_TIMEOUT_POLLS
+#define LCD_BUSY_TIMEOUT_POLLS   2000U
+#endif
+
 /* --- API Pública de Control --- */
 
 /**
  * @brief Inicializa el LCD en modo de 4 bits.
  * @details Realiza la secuencia de reset por software y configura el Function Set.
  * @param config Puntero a la estructura de configuración (se recomienda persistencia en SRAM).
- * @note Requiere que los pines ya estén configurados como SALIDAS en la Capa 1.
+ * @note Requiere que los pines ya estén configurados como SALIDAS en la Capa 1 (R/W
+ * incluido, si se usa). La secuencia de reset siempre usa retardos fijos; el Busy Flag
+ * se consulta a partir del primer comando en modo 4 bits.
  */
 void LCD_Init(const LCD_Config_t *config);
 
+/**
+ * @brief Indica si el driver está consultando el Busy Flag (false: retardos fijos).
+ */
+bool LCD_IsBusyFlagMode(void);
+
 /**
  * @brief Limpia la pantalla y regresa el cursor a la posición (0,0).
  * @note Esta operación es lenta (requiere ~1.52ms de espera).
@@ -107,4 +134,40 @@ void LCD_Shift(lcd_shift_dir_t direction);
  */
 void LCD_CreateCustomChar(uint8_t location, uint8_t charmap[]);
 
+/* --- API del Framebuffer (Shadow DDRAM) --- */
+
+/** @brief Presupuesto mínimo de @ref LCD_FB_Flush: el costo de la celda más cara. */
+#define LCD_FB_MIN_BUDGET   2
+
+/**
+ * @brief Activa o desactiva el modo framebuffer.
+ * @details Con el modo activo, @ref LCD_SetCursor, @ref LCD_Print, @ref LCD_WriteChar y
+ * @ref LCD_Clear escriben sobre una copia de la DDRAM en SRAM (80 bytes + 10 de
+ * marcas) y no tocan el bus: cuestan unos pocos ciclos por carácter. Solo se marcan
+ * las celdas cuyo contenido cambia. Al activarlo la pantalla se limpia para que la
+ * copia y el display partan iguales.
+ * @param enable true: framebuffer; false: escritura directa (volcar antes con
+ * @ref LCD_FB_Flush para no perder cambios pendientes).
+ */
+void LCD_FB_Enable(bool enable);
+
+/**
+ * @brief Envía al display las celdas modificadas, con un presupuesto de bytes por llamada.
+ * @details Recorre las celdas en orden y retoma donde quedó la llamada anterior. Las
+ * celdas modificadas contiguas se envían seguidas aprovechando el auto-incremento de
+ * la DDRAM; solo un salto de dirección cuesta un comando extra. Cada byte del bus
+ * bloquea lo que tarde @ref LCD_SendByte, por lo que el presupuesto acota el tiempo
+ * de la llamada.
+ * @param max_bytes Bytes (datos + comandos de dirección) a enviar como máximo. Valores
+ * menores que @ref LCD_FB_MIN_BUDGET se elevan a ese mínimo, para que toda llamada
+ * avance al menos una celda.
+ * @return true si no quedan celdas pendientes.
+ */
+bool LCD_FB_Flush(uint8_t max_bytes);
+
+/**
+ * @brief Indica si hay celdas del framebuffer sin enviar.
+ */
+bool LCD_FB_IsDirty(void);
+
 #endif /* LCD_DRIVER_H_ */
\ No newline at end of file
@@ -4,20 +4,27 @@
  * @author Mamani Flores Carlos
  * @date 2026
  * * @details Este módulo proporciona una abstracción completa para la gestión de LEDs RGB.
- * Está diseñado bajo el principio de "Inyección de Dependencias", siendo agnóstico 
- * a la plataforma de hardware (AVR, STM32, PIC). La vinculación con la Capa 1 (HAL)
- * se realiza mediante punteros a funciones (callbacks) definidos durante la inicialización.
+ * Está diseñado bajo el principio de "Inyección de Dependencias": la vinculación con la
+ * Capa 1 (HAL) se realiza mediante descriptores de canal PWM (@ref pwm8_channel_t) que
+ * apuntan directamente al registro OCRnx, sin callbacks ni bifurcaciones por canal.
  */
 
 #ifndef RGB_LED_DRIVER_H_
 #define RGB_LED_DRIVER_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "pwm_channel.h"
 
-/** * @brief Definición de puntero a función para la manipulación del Duty Cycle.
- * @param duty Valor de 8 bits (0-255) que representa el ciclo de trabajo.
+/**
+ * @brief Pasos del círculo cromático: 6 sectores de 256 (0 = Rojo, 512 = Verde, 1024 = Azul).
+ */
+#define RGB_HUE_STEPS   1536U
+
+/**
+ * @brief Intensidad máxima en Q8.4 (255.0) para @ref RGB_Set_Color_Fine.
  */
-typedef void (*pwm_set_duty_t)(uint8_t duty);
+#define RGB_FINE_MAX    4080U
 
 /**
  * @enum rgb_type_t
@@ -46,13 +53,13 @@ typedef enum {
 /**
  * @struct RGB_LED_t
  * @brief Estructura de control para una instancia de LED RGB.
- * * @details Contiene tanto los punteros a las funciones de hardware como
+ * * @details Contiene tanto los canales de hardware (registros OCR) como
  * el estado actual de los canales para permitir operaciones de lectura/escritura.
  */
 typedef struct {
-    pwm_set_duty_t set_red;   /**< Callback para el canal Rojo. */
-    pwm_set_duty_t set_green; /**< Callback para el canal Verde. */
-    pwm_set_duty_t set_blue;  /**< Callback para el canal Azul. */
+    pwm8_channel_t ch_red;    /**< Registro OCR del canal Rojo. */
+    pwm8_channel_t ch_green;  /**< Registro OCR del canal Verde. */
+    pwm8_channel_t ch_blue;   /**< Registro OCR del canal Azul. */
     
     rgb_type_t type;          /**< Configuración de hardware (Ánodo/Cátodo). */
     uint8_t max_brightness;   /**< Límite superior de intensidad (0-255). */
@@ -60,21 +67,37 @@ typedef struct {
     uint8_t current_r;        /**< Intensidad roja actual en memoria. */
     uint8_t current_g;        /**< Intensidad verde actual en memoria. */
     uint8_t current_b;        /**< Intensidad azul actual en memoria. */
+
+    uint16_t hue;             /**< Tono HSV actual (0 a @ref RGB_HUE_STEPS - 1). */
+    uint8_t saturation;       /**< Saturación HSV actual (0-255). */
+    uint8_t value;            /**< Brillo HSV actual (0-255, escalado por max_brightness). */
+
+    bool dither;              /**< Dithering temporal activo (@ref RGB_Dither_Enable). */
+    uint8_t dither_frac[3];   /**< Fracción Q.4 de R, G y B (0-15) a modular. */
+    uint8_t dither_acc[3];    /**< Acumulador del modulador de cada canal. */
+
+    bool batched;             /**< Instancia agrupada: los Set_* solo preparan el color. */
+    volatile bool staged;     /**< Hay un color preparado esperando el commit. */
+    uint16_t staged_rgb[3];   /**< Color preparado en Q8.4 (ya limitado por max_brightness). */
+    volatile bool committed;  /**< Hay una copia del color esperando a la ISR de commit. */
+    uint16_t commit_rgb[3];   /**< Copia tomada por @ref RGB_Commit_At_Top (la lee la ISR). */
 } RGB_LED_t;
 
 /* --- API Pública --- */
 
 /**
- * @brief Inicializa el objeto LED RGB y vincula los callbacks de hardware.
+ * @brief Inicializa el objeto LED RGB y vincula los canales PWM de hardware.
  * * @param led Puntero a la estructura de control del LED.
  * @param type Polaridad del LED (@ref rgb_type_t).
  * @param max_br Brillo máximo permitido para esta instancia.
- * @param f_red Función de la Capa 1 para el canal Rojo.
- * @param f_green Función de la Capa 1 para el canal Verde.
- * @param f_blue Función de la Capa 1 para el canal Azul.
+ * @param ch_red Canal PWM del Rojo (ej. PWM_CH_T0A).
+ * @param ch_green Canal PWM del Verde (ej. PWM_CH_T0B).
+ * @param ch_blue Canal PWM del Azul (ej. PWM_CH_T2A).
+ * @note Los tres canales son obligatorios y deben estar configurados en Fast PWM. Si
+ * alguno es NULL la instancia no se inicializa.
  */
 void RGB_Init(RGB_LED_t *led, rgb_type_t type, uint8_t max_br, 
-              pwm_set_duty_t f_red, pwm_set_duty_t f_green, pwm_set_duty_t f_blue);
+              pwm8_channel_t ch_red, pwm8_channel_t ch_green, pwm8_channel_t ch_blue);
 
 /**
  * @brief Establece un color RGB específico de forma inmediata.
@@ -94,4 +117,150 @@ void RGB_Set_Color_Direct(RGB_LED_t *led, uint8_t r, uint8_t g, uint8_t b);
  */
 void RGB_Set_Preset(RGB_LED_t *led, RGB_PresetColor_t color);
 
+/* --- API HSV (corrección Gamma) --- */
+
+/**
+ * @brief Establece el color en espacio HSV con corrección Gamma.
+ * @details Conversión entera (sin divisiones): el sector sale de los 8 bits altos del
+ * tono y la mezcla de 3 productos de 8x8 bits. Cada canal pasa luego por una tabla
+ * Gamma 2.2 en FLASH (Q8.4), por lo que los pasos de brillo bajo se perciben uniformes;
+ * con dithering activo se aprovechan los 12 bits de la tabla.
+ * @param led Puntero a la instancia del LED.
+ * @param hue Tono (0 a @ref RGB_HUE_STEPS - 1).
+ * @param sat Saturación (0 = blanco, 255 = color puro).
+ * @param val Brillo percibido (0-255), escalado por max_brightness.
+ */
+void RGB_Set_HSV(RGB_LED_t *led, uint16_t hue, uint8_t sat, uint8_t val);
+
+/**
+ * @brief Cambia solo el tono conservando saturación y brillo.
+ */
+void RGB_Set_Hue(RGB_LED_t *led, uint16_t hue);
+
+/**
+ * @brief Cambia solo el brillo conservando tono y saturación.
+ */
+void RGB_Set_Brightness(RGB_LED_t *led, uint8_t val);
+
+/**
+ * @brief Avanza el tono en el círculo cromático (un incremento por frame).
+ * @details Dentro de un sector HSV solo recalcula y escribe el canal que cambia; la
+ * conversión completa se hace al cruzar de sector (6 veces por vuelta con paso 1).
+ * Pensada para una tarea cooperativa, no para una ISR.
+ * @note Parte del último color HSV: tras un Set_Color_Direct, Set_Color_Fine o Set_Preset
+ * llamar a @ref RGB_Set_Hue antes de volver a avanzar el tono.
+ * @param led Puntero a la instancia del LED.
+ * @param step Incremento de tono (menor que @ref RGB_HUE_STEPS).
+ */
+void RGB_Hue_Step(RGB_LED_t *led, uint16_t step);
+
+/* --- API de Dithering Temporal --- */
+
+/**
+ * @brief Establece un color con 4 bits fraccionarios (Q8.4, 0 a @ref RGB_FINE_MAX).
+ * @details Con dithering activo la fracción se modula en el tiempo (12 bits efectivos);
+ * sin dithering se redondea a 8 bits.
+ * @param led Puntero a la instancia del LED.
+ * @param r Intensidad del Rojo en Q8.4.
+ * @param g Intensidad del Verde en Q8.4.
+ * @param b Intensidad del Azul en Q8.4.
+ */
+void RGB_Set_Color_Fine(RGB_LED_t *led, uint16_t r, uint16_t g, uint16_t b);
+
+/**
+ * @brief Activa o desactiva el dithering temporal de la instancia.
+ * @details La aplicación debe habilitar la interrupción de Overflow del Timer de los
+ * canales (ej. Timer0_PWM_IT_Overflow(1)) e invocar @ref RGB_Dither_IRQHandler.
+ * Al desactivar, los OCR vuelven a la parte entera del color.
+ */
+void RGB_Dither_Enable(RGB_LED_t *led, bool enable);
+
+/**
+ * @brief Modulador de primer orden de un canal: la fracción (0-15) se acumula en
+ * 1/16 de 256; el acarreo suma un nivel de PWM en este periodo.
+ * @details Sin carga fraccionaria pendiente la base nunca es 255 (el máximo Q8.4 es
+ * 4080 = 255.0), por lo que base + 1 no desborda.
+ */
+static inline uint8_t RGB_Dither_Channel(RGB_LED_t *led, uint8_t i, uint8_t base) {
+    uint8_t prev = led->dither_acc[i];
+    led->dither_acc[i] = prev + (led->dither_frac[i] << 4);
+    base += (led->dither_acc[i] < prev);
+    return (led->type == RGB_ANODE_COMMON) ? (255 - base) : base;
+}
+
+/**
+ * @brief Alterna cada canal entre 'n' y 'n+1' según su fracción (Sigma-Delta de 1er orden).
+ * @details Debe llamarse una vez por periodo de PWM desde la ISR de Overflow. En 16
+ * periodos el promedio de cada canal es exacto al 1/16 de nivel: 4 bits extra de
+ * profundidad. Es inline para que la ISR no pague una llamada ni, por ella, el guardado
+ * de todos los registros call-clobbered.
+ * * Costo estimado por conteo de instrucciones (no medido en hardware), con la instancia
+ * global (direcciones constantes, LDS/STS):
+ * - Cuerpo: ~80 ciclos por LED (3 x ~26: acumulador, acarreo, polaridad y un ST al OCR).
+ * - ISR que solo contiene este handler: ~50 ciclos de respuesta, prólogo/epílogo y RETI;
+ * ~130 ciclos por periodo, 6.3% de CPU a 7.8kHz (clk/8).
+ * - Si la misma ISR llama a funciones no inline (ej. @ref RGB_Batch_IRQHandler), GCC
+ * guarda r18-r27, r30 y r31 en cada entrada: ~170 ciclos, 8.5% de CPU a 7.8kHz.
+ * Verificar con: avr-objdump -d app.elf | sed -n '/<__vector_16>:/,/reti/p'.
+ * @note Si los canales están en dos Timers (0 y 2), ambos deben usar el mismo prescaler:
+ * los OCR del otro Timer se actualizan en su propio BOTTOM, un periodo idéntico.
+ * Con clk/8 (7.8kHz) el ciclo de 16 periodos se repite a 488Hz, sin parpadeo visible.
+ */
+static inline void RGB_Dither_IRQHandler(RGB_LED_t *led) {
+    if (!led->dither) return;
+
+    PWM_WRITE(led->ch_red,   RGB_Dither_Channel(led, 0, led->current_r));
+    PWM_WRITE(led->ch_green, RGB_Dither_Channel(led, 1, led->current_g));
+    PWM_WRITE(led->ch_blue,  RGB_Dither_Channel(led, 2, led->current_b));
+}
+
+/* --- API de Actualización por Lotes --- */
+
+/**
+ * @brief Agrupa instancias para actualizarlas juntas.
+ * @details Desde esta llamada, las funciones Set_* de esas instancias (directo, preset,
+ * HSV, Q8.4) solo preparan el color; el hardware cambia al invocar @ref RGB_Commit o
+ * @ref RGB_Commit_At_Top, todas las instancias a la vez. Preparar nunca espera a la ISR:
+ * cada instancia tiene dos buffers (el que escriben los Set_* y la copia del commit), por
+ * lo que los Set_* pueden llamarse con interrupciones bloqueadas o desde una ISR.
+ * @param leds Tabla de instancias (debe permanecer válida; puede estar en .data).
+ * @param count Cantidad de instancias.
+ */
+void RGB_Batch_Init(RGB_LED_t *const *leds, uint8_t count);
+
+/**
+ * @brief Aplica de inmediato todos los colores preparados en una sola sección crítica.
+ * @details Ningún color queda a medias frente a una ISR. Los OCR con doble buffer
+ * cambian en el BOTTOM siguiente de cada Timer; si un BOTTOM cae dentro de la sección
+ * crítica, los canales de ese Timer pueden repartirse en dos periodos consecutivos.
+ */
+void RGB_Commit(void);
+
+/**
+ * @brief Solicita aplicar los colores preparados al comienzo del próximo periodo.
+ * @details Copia los colores preparados (sección crítica de 6 bytes por instancia) y
+ * delega la escritura a @ref RGB_Batch_IRQHandler. Los canales de un mismo Timer entran
+ * juntos en su BOTTOM; si el lote usa dos Timers desfasados, cada uno cambia en su propio
+ * BOTTOM (ver la nota de @ref RGB_Batch_IRQHandler). Un segundo commit antes de que la
+ * ISR tome el primero lo reemplaza: se aplica siempre el último color completo.
+ */
+void RGB_Commit_At_Top(void);
+
+/**
+ * @brief Indica si un @ref RGB_Commit_At_Top aún no fue aplicado.
+ */
+bool RGB_Commit_IsPending(void);
+
+/**
+ * @brief Aplica el commit pendiente. Debe llamarse desde la ISR de Overflow del Timer
+ * de los canales, antes de @ref RGB_Dither_IRQHandler.
+ * @note Con canales en los Timers 0 y 2 basta la ISR del Timer 0 si ambos comparten
+ * prescaler, pero los OCR no entran en el mismo BOTTOM: cada Timer toma los suyos en su
+ * propio BOTTOM. Con el Timer 2 desfasado medio periodo (proyecto 10) el Azul cambia
+ * medio periodo antes que Rojo y Verde (64µs con clk/8), siempre que la ISR termine
+ * antes de ese BOTTOM (1024 ciclos de margen); si no, un periodo y medio después.
+ * Ningún periodo de un mismo Timer mezcla dos colores.
+ */
+void RGB_Batch_IRQHandler(void);
+
 #endif /* RGB_LED_DRIVER_H_ */
\ No newline at end of file
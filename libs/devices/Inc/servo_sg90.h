@@ -3,19 +3,80 @@
  * @brief Driver genérico para el control de servomotores SG90.
  * @author Mamani Flores Carlos
  * @details Este driver permite gestionar múltiples instancias de servos
- * mediante inyección de dependencias, siendo independiente del Timer utilizado.
+ * mediante inyección de dependencias (canal PWM de 16 bits o multiplexor por GPIO),
+ * siendo independiente del Timer utilizado.
  */
 
 #ifndef SERVO_SG90_H_
 #define SERVO_SG90_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "pwm_channel.h"
+
+/** * @name Multiplexor de Servos (Timer 1)
+ * @{
+ */
+
+/** @brief Cantidad máxima de servos multiplexados sobre el Timer 1 (5 por canal OCR1A/OCR1B). */
+#define SERVO_MUX_MAX_CHANNELS  10
+
+/** @brief Servos asignados a cada canal de comparación (grupo A y grupo B). */
+#define SERVO_MUX_GROUP_SIZE    (SERVO_MUX_MAX_CHANNELS / 2)
+
+/**
+ * @brief Duración de un frame en ticks del Timer 1.
+ * @note Con F_CPU = 16MHz y prescaler 8 (tick de 0.5us), 40000 ticks = 20ms (50Hz).
+ */
+#define SERVO_MUX_FRAME_TICKS   40000U
+
+/**
+ * @brief Anticipación (en ticks) con la que se dispara cada Compare Match.
+ * @details La ISR despierta antes del flanco y espera activamente sobre TCNT1 hasta el
+ * tick exacto. Mientras ninguna otra ISR demore más que este margen (16 ticks = 8us),
+ * el jitter del flanco queda por debajo de un tick del Timer.
+ */
+#define SERVO_MUX_LEAD_TICKS    16U
+
+/** @brief Valor de 'mux_channel' para servos conectados a un OCR de hardware. */
+#define SERVO_MUX_NONE          0xFF
+
+/** @} */
+
+/** @brief Ángulo máximo en décimas de grado (180.0°). */
+#define SERVO_DECIDEG_MAX       1800U
+
+/** * @name Perfilador de Movimiento
+ * @{
+ */
+
+/** @brief Cantidad máxima de servos con perfil de movimiento activo. */
+#define SERVO_MOTION_MAX        SERVO_MUX_MAX_CHANNELS
 
 /**
- * @brief Definición del puntero a función para la capa de abstracción de hardware.
- * @param ticks Valor de comparación (OCR) calculado según la resolución del Timer.
+ * @brief Frecuencia con la que se invoca @ref Servo_Motion_Update (Hz).
+ * @note 50Hz si se llama desde el overflow de un PWM de 20ms, o con el multiplexor (que
+ * la invoca él mismo en cada frame de 20ms). Puede redefinirse antes de incluir este
+ * archivo si el perfil se actualiza a otra tasa.
  */
-typedef void (*servo_write_hw_ptr)(uint16_t ticks);
+#ifndef SERVO_MOTION_HZ
+#define SERVO_MOTION_HZ         50U
+#endif
+
+/**
+ * @brief Convierte grados/s a unidades internas de velocidad.
+ * @details El perfil trabaja en 1/16 de décima de grado (Q4) por frame.
+ * Ejemplo: SERVO_VEL_DPS(120) = 384 (120°/s a 50Hz).
+ */
+#define SERVO_VEL_DPS(dps)      ((uint16_t)(((uint32_t)(dps) * 160UL) / SERVO_MOTION_HZ))
+
+/**
+ * @brief Convierte grados/s² a unidades internas de aceleración (Q4 décimas/frame²).
+ * @note Resolución a 50Hz: 1 unidad = 15.6°/s².
+ */
+#define SERVO_ACC_DPS2(dps2)    ((uint16_t)(((uint32_t)(dps2) * 160UL) / ((uint32_t)SERVO_MOTION_HZ * SERVO_MOTION_HZ)))
+
+/** @} */
 
 /**
  * @brief Estructura de control para una instancia de Servo.
@@ -24,7 +85,15 @@ typedef void (*servo_write_hw_ptr)(uint16_t ticks);
 typedef struct {
     uint16_t min_ticks;         /**< Ticks para posición 0° (aprox 1.0ms) */
     uint16_t max_ticks;         /**< Ticks para posición 180° (aprox 2.0ms) */
-    servo_write_hw_ptr write_hw; /**< Callback hacia la Capa 1 (Wrapper del Timer) */
+    uint32_t scale_q16;         /**< Ticks por décima de grado en Q16 (precalculado en la inicialización) */
+    pwm16_channel_t ocr;        /**< Registro OCR de hardware (0 si usa el multiplexor) */
+    uint8_t  mux_channel;       /**< Canal del multiplexor (SERVO_MUX_NONE si usa 'ocr') */
+    int16_t  mp_pos;            /**< Posición actual del perfil (Q4 décimas de grado) */
+    int16_t  mp_target;         /**< Posición objetivo (Q4 décimas de grado) */
+    int16_t  mp_vel;            /**< Velocidad actual con signo (Q4 décimas/frame) */
+    uint16_t mp_vmax;           /**< Velocidad máxima (ver @ref SERVO_VEL_DPS) */
+    uint16_t mp_accel;          /**< Aceleración (ver @ref SERVO_ACC_DPS2), 0 = velocidad constante */
+    volatile uint8_t mp_moving; /**< 1 mientras el perfil está en curso */
 } Servo_t;
 
 /**
@@ -32,9 +101,9 @@ typedef struct {
  * @param instance Puntero a la estructura Servo_t.
  * @param min Ticks correspondientes al ancho de pulso mínimo.
  * @param max Ticks correspondientes al ancho de pulso máximo.
- * @param callback Función de hardware que escribe en el registro OCR.
+ * @param ocr Canal PWM de 16 bits (ej. PWM_CH_T1A) configurado en Fast PWM de 20ms.
  */
-void Servo_Init(Servo_t *instance, uint16_t min, uint16_t max, servo_write_hw_ptr callback);
+void Servo_Init(Servo_t *instance, uint16_t min, uint16_t max, pwm16_channel_t ocr);
 
 /**
  * @brief Establece el ángulo de un servo específico.
@@ -43,4 +112,79 @@ void Servo_Init(Servo_t *instance, uint16_t min, uint16_t max, servo_write_hw_pt
  */
 void Servo_SetAngle(Servo_t *instance, uint8_t angle);
 
+/**
+ * @brief Establece el ángulo de un servo con resolución de décimas de grado.
+ * @details Sin divisiones: una multiplicación 16x32 y un desplazamiento por el
+ * factor Q16 precalculado en la inicialización.
+ * @param instance Puntero a la instancia del servo a mover.
+ * @param decideg Ángulo en décimas de grado (rango 0 - 1800).
+ */
+void Servo_SetAngle_Deci(Servo_t *instance, uint16_t decideg);
+
+/* --- API del Perfilador de Movimiento --- */
+
+/**
+ * @brief Inicia un movimiento trapezoidal hacia un ángulo objetivo.
+ * @details El servo acelera hasta vmax, crucero, y frena para llegar al objetivo sin
+ * sobrepaso. Toda la trayectoria se ejecuta en @ref Servo_Motion_Update; el loop
+ * principal no interviene. Un nuevo objetivo puede emitirse en pleno movimiento.
+ * @param instance Puntero a la instancia del servo.
+ * @param decideg Ángulo objetivo en décimas de grado (0 - 1800).
+ * @param vmax Velocidad máxima (usar @ref SERVO_VEL_DPS). 0 = salto inmediato.
+ * @param accel Aceleración (usar @ref SERVO_ACC_DPS2). 0 = velocidad constante.
+ * @return false si no quedan lugares en el registro de servos en movimiento.
+ */
+bool Servo_MoveTo(Servo_t *instance, uint16_t decideg, uint16_t vmax, uint16_t accel);
+
+/**
+ * @brief Indica si el servo aún no alcanzó su objetivo.
+ */
+bool Servo_IsMoving(const Servo_t *instance);
+
+/**
+ * @brief Avanza un frame el perfil de todos los servos registrados.
+ * @note Debe llamarse una vez por frame de PWM, típicamente desde ISR(TIMER1_OVF_vect)
+ * con el Timer 1 en Fast PWM de 20ms (ver @ref SERVO_MOTION_HZ).
+ * @warning Con el multiplexor NO debe llamarse desde la aplicación: el Timer 1 corre en
+ * Modo Normal y su Overflow ocurre cada 32.768ms (no 20ms), lo que haría el perfil 1.64
+ * veces más lento. El manejador del grupo A la invoca en cada frame de 20ms.
+ */
+void Servo_Motion_Update(void);
+
+/* --- API del Multiplexor de Servos (Timer 1 + GPIO arbitrarios) --- */
+
+/**
+ * @brief Configura el Timer 1 como base de tiempo del multiplexor de servos.
+ * @details Inicializa el Timer 1 en Modo Normal (prescaler 8) y arma las Alarmas A y B.
+ * Cada canal de comparación atiende un grupo de hasta @ref SERVO_MUX_GROUP_SIZE servos;
+ * el grupo B arranca medio frame después del grupo A para repartir la carga.
+ * El Timer 1 queda en Modo Normal (cuenta libre de 0 a 65535): su Overflow no marca
+ * el frame, por eso el multiplexor genera él mismo el tick de 20ms del perfilador.
+ * @note La aplicación debe invocar @ref Servo_Mux_IRQHandler_A desde ISR(TIMER1_COMPA_vect)
+ * y @ref Servo_Mux_IRQHandler_B desde ISR(TIMER1_COMPB_vect).
+ */
+void Servo_Mux_Init(void);
+
+/**
+ * @brief Inicializa un servo conectado a un GPIO cualquiera y lo registra en el multiplexor.
+ * @param instance Puntero a la estructura Servo_t.
+ * @param min Ticks correspondientes al ancho de pulso mínimo (0.5us por tick).
+ * @param max Ticks correspondientes al ancho de pulso máximo.
+ * @param port Registro PORTx del pin de señal (ej. &PORTD).
+ * @param pin Número de pin (0-7).
+ * @return true si el servo fue registrado, false si no quedan canales libres.
+ * @note El pin se configura como salida automáticamente (DDRx = PORTx - 1).
+ */
+bool Servo_Init_Mux(Servo_t *instance, uint16_t min, uint16_t max, volatile uint8_t *port, uint8_t pin);
+
+/**
+ * @brief Manejador del grupo A. Debe llamarse desde ISR(TIMER1_COMPA_vect).
+ */
+void Servo_Mux_IRQHandler_A(void);
+
+/**
+ * @brief Manejador del grupo B. Debe llamarse desde ISR(TIMER1_COMPB_vect).
+ */
+void Servo_Mux_IRQHandler_B(void);
+
 #endif /* SERVO_SG90_H_ */
\ No newline at end of file
@@ -15,6 +15,7 @@
 #include <avr/io.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "pwm_channel.h"
 
 /** * @name Tipos de Configuración de Giro
  * @{ 
@@ -26,9 +27,20 @@
  */
 typedef enum {
     MODE_FULL_STEP = 0,    /**< 4 pasos por secuencia. Prioriza el torque de retención. */
-    MODE_HALF_STEP = 1     /**< 8 pasos por secuencia. Prioriza la suavidad y resolución angular. */
+    MODE_HALF_STEP = 1,    /**< 8 pasos por secuencia. Prioriza la suavidad y resolución angular. */
+    MODE_MICRO_STEP = 2    /**< Micropasos senoidales por PWM (1/8 a 1/32 de paso). */
 } Step_Mode_t;
 
+/**
+ * @enum Step_Micro_t
+ * @brief Resolución del micropaso (divisor del paso completo, expresado como potencia de 2).
+ */
+typedef enum {
+    MICRO_1_8  = 3,        /**< 8 micropasos por paso completo. */
+    MICRO_1_16 = 4,        /**< 16 micropasos por paso completo. */
+    MICRO_1_32 = 5         /**< 32 micropasos por paso completo (resolución de la tabla). */
+} Step_Micro_t;
+
 /**
  * @enum Step_Dir_t
  * @brief Define el sentido de rotación del eje.
@@ -40,21 +52,112 @@ typedef enum {
 
 /** @} */
 
+struct Stepper_s;
+
+/**
+ * @brief Callback invocado (desde la ISR de pasos) al alcanzar la posición objetivo.
+ */
+typedef void (*stepper_done_cb_t)(struct Stepper_s* hstepper);
+
 /**
  * @struct Stepper_t
  * @brief Estructura de control para el encapsulamiento de cada instancia del motor.
  * * @note El uso de punteros a registros 'volatile uint8_t*' permite que este objeto 
  * sea agnóstico a la posición física de los pines, facilitando el ruteo del PCB.
  */
-typedef struct {
+typedef struct Stepper_s {
     volatile uint8_t* GPIO_Ports[4]; /**< Direcciones de memoria de los puertos (ej: &PORTB) para IN1..IN4. */
     uint8_t           GPIO_Pins[4];  /**< Números de pin (0-7) asociados a cada puerto de fase. */
-    int8_t            current_step;  /**< Índice interno de la secuencia de pasos. */
+    volatile uint8_t* port_reg[4];   /**< Puertos distintos usados por las fases (precalculado). */
+    uint8_t           port_mask[4];  /**< Pines del motor dentro de cada puerto. */
+    uint8_t           port_count;    /**< Cantidad de puertos distintos (1 a 4). */
+    uint8_t           phase_bits[8][4]; /**< Valor de cada puerto para cada paso de la secuencia. */
+    pwm8_channel_t    pwm[4];        /**< Registros OCR de IN1..IN4 (solo MODE_MICRO_STEP). */
+    uint8_t           micro_stride;  /**< Avance de la fase eléctrica por micropaso (32 = paso completo). */
+    uint8_t           micro_per_step;/**< Micropasos por paso completo (8, 16 o 32). */
+    uint8_t           micro_phase;   /**< Fase eléctrica aplicada a los OCR (0-127). */
+    uint16_t          micro_ticks;   /**< Overflows del Timer PWM desde el último paso (satura). */
+    uint16_t          micro_period;  /**< Overflows que duró el paso anterior (base de la interpolación). */
+    uint16_t          micro_acc;     /**< Acumulador del interpolador (DDA). */
+    uint16_t          hold_timeout;  /**< Ticks de servicio sin pasos antes de reducir corriente (0 = desactivado). */
+    uint16_t          idle_ticks;    /**< Ticks de servicio transcurridos desde el último paso. */
+    uint8_t           hold_duty;     /**< Corriente de retención (0-255 sobre la corriente nominal). */
+    uint8_t           chop_acc;      /**< Acumulador del chopper por software (sigma-delta). */
+    bool              chop_on;       /**< Estado actual de las fases durante la retención. */
+    bool              holding;       /**< true: corriente reducida en curso. */
+    volatile int32_t  position;      /**< Posición absoluta en pasos (CW suma, CCW resta). */
+    volatile int32_t  target;        /**< Posición objetivo del movimiento en curso. */
+    volatile bool     positioning;   /**< true: movimiento a 'target' en curso (se limpia al llegar). */
+    volatile bool     move_done;     /**< Se activa al llegar a 'target'. */
+    stepper_done_cb_t on_done;       /**< Callback opcional al llegar a 'target' (contexto ISR). */
+    int8_t            current_step;  /**< Índice de la secuencia (en micropaso: fase objetivo 0-127). */
     Step_Mode_t       mode;          /**< Modo de operación seleccionado (Full/Half). */
     Step_Dir_t        direction;     /**< Sentido de giro configurado. */
-    bool              is_active;     /**< Flag de habilitación del movimiento. */
+    volatile bool     is_active;     /**< Flag de habilitación del movimiento (admite pasos). */
+    bool              energized;     /**< Bobinas con corriente (hubo pasos desde el último Stop). */
 } Stepper_t;
 
+/** * @name Generador de Rampas (Perfil de Velocidad)
+ * @{ 
+ */
+
+/**
+ * @brief Frecuencia del Timer que temporiza los pasos (Hz).
+ * @note Por defecto Timer 1 con prescaler 64 (tick de 4us a 16MHz). Redefinir en el
+ * Makefile (-DSTEPPER_TIMER_HZ=...) si se usa otro prescaler.
+ */
+#ifndef STEPPER_TIMER_HZ
+#define STEPPER_TIMER_HZ        (F_CPU / 64UL)
+#endif
+
+/**
+ * @brief Menor velocidad de arranque representable (pasos/s).
+ * @details El intervalo entre pasos es de 16 bits: F / start_sps debe ser <= 0xFFFF.
+ * Con el Timer por defecto (250kHz) son 4 pasos/s.
+ */
+#define STEPPER_RAMP_MIN_SPS    ((uint16_t)(STEPPER_TIMER_HZ / 65535UL + 1))
+
+/**
+ * @brief Constante de aceleración: 2^48 / F² (se resuelve en tiempo de compilación).
+ * @details Convierte una aceleración en pasos/s² al incremento de velocidad por tick
+ * en el formato interno (V = 2^32 / intervalo).
+ */
+#define STEPPER_RAMP_K          ((uint32_t)(281474976710656.0 / ((double)STEPPER_TIMER_HZ * (double)STEPPER_TIMER_HZ)))
+
+/**
+ * @enum Ramp_State_t
+ * @brief Fase del perfil trapezoidal.
+ */
+typedef enum {
+    RAMP_IDLE   = 0,       /**< Motor detenido. */
+    RAMP_ACCEL  = 1,       /**< Acelerando hacia la velocidad máxima. */
+    RAMP_CRUISE = 2,       /**< Velocidad constante. */
+    RAMP_DECEL  = 3        /**< Frenando hacia la velocidad de arranque. */
+} Ramp_State_t;
+
+/**
+ * @struct Stepper_Ramp_t
+ * @brief Estado del generador de rampas de un motor.
+ * * @details La velocidad se representa como V = 2^32 / c, donde c es el intervalo
+ * entre pasos en ticks del Timer. Así el incremento de velocidad por paso y el nuevo
+ * intervalo se obtienen solo con multiplicaciones y desplazamientos (ver .c).
+ */
+typedef struct {
+    uint32_t          accel_k;      /**< Aceleración escalada: accel * STEPPER_RAMP_K. */
+    uint32_t          v;            /**< Velocidad actual (2^32 / c). */
+    uint32_t          v_start;      /**< Velocidad de arranque (pull-in). */
+    uint32_t          v_max;        /**< Velocidad de crucero. */
+    uint16_t          c;            /**< Intervalo actual entre pasos (ticks). */
+    uint16_t          c_start;      /**< Intervalo a la velocidad de arranque. */
+    uint16_t          c_min;        /**< Intervalo a la velocidad de crucero. */
+    uint32_t          steps_left;   /**< Pasos restantes del movimiento. */
+    uint32_t          accel_steps;  /**< Pasos invertidos en acelerar (define el frenado). */
+    volatile uint8_t  state;        /**< Fase actual (Ramp_State_t). */
+    bool              continuous;   /**< true: giro continuo sin objetivo. */
+} Stepper_Ramp_t;
+
+/** @} */
+
 /* --- API Pública de Control --- */
 
 /**
@@ -62,14 +165,45 @@ typedef struct {
  * * @param hstepper Puntero al handle (instancia) del motor.
  * @param ports Arreglo de 4 punteros a registros PORTx (IN1, IN2, IN3, IN4).
  * @param pins Arreglo de 4 números de pin (0-7) correspondientes a las fases.
- * @param mode Modo de paso inicial.
+ * @param mode Modo de paso inicial (MODE_FULL_STEP o MODE_HALF_STEP).
+ * @note MODE_MICRO_STEP se rechaza (requiere canales PWM, ver @ref Stepper_Init_Micro):
+ * el motor queda inerte.
  */
 void Stepper_Init(Stepper_t* hstepper, volatile uint8_t* ports[], uint8_t pins[], Step_Mode_t mode);
 
+/**
+ * @brief Inicializa un motor en modo micropaso con las bobinas manejadas por PWM.
+ * * @details Cada entrada del ULN2003 (IN1..IN4) debe estar conectada a un canal PWM
+ * por hardware (ej. OC0A, OC0B, OC2A, OC2B). La corriente de cada bobina sigue la parte
+ * positiva de un coseno desfasado 90° eléctricos respecto de la anterior.
+ * La ISR de pasos sigue trabajando a tasa de paso completo (@ref Stepper_Step_Sequential
+ * avanza 90° y la posición se cuenta en pasos completos); los micropasos intermedios los
+ * genera @ref Stepper_Micro_IRQHandler desde el Overflow del Timer PWM.
+ * * @param hstepper Puntero al handle del motor.
+ * @param pwm Arreglo de 4 canales PWM de 8 bits (IN1, IN2, IN3, IN4), ej. PWM_CH_T0A.
+ * @param resolution Micropasos por paso completo (MICRO_1_8 a MICRO_1_32).
+ * @note Los Timers PWM deben configurarse previamente en el Hardware Mapping. Si algún
+ * canal es NULL el motor queda inerte (sin salidas) y no se mueve.
+ */
+void Stepper_Init_Micro(Stepper_t* hstepper, const pwm8_channel_t pwm[], Step_Micro_t resolution);
+
+/**
+ * @brief Interpolador de micropasos. Llamar desde la ISR de Overflow del Timer PWM.
+ * * @details Mide cuántos overflows dura cada paso y reparte los micropasos del paso en
+ * curso a lo largo de ese intervalo (DDA, sin divisiones). La ISR de pasos no cambia de
+ * frecuencia con la resolución: solo la de Overflow, que ya existe, escribe los OCR.
+ * * @param hstepper Puntero al handle del motor.
+ * @note Debe ejecutarse en el mismo nivel de prioridad que los pasos (otra ISR). Si los
+ * pasos son más rápidos que el Overflow la salida degenera a paso completo.
+ */
+void Stepper_Micro_IRQHandler(Stepper_t* hstepper);
+
 /**
  * @brief Ejecuta el siguiente paso lógico de la secuencia.
  * * @details Esta función es NO-BLOQUEANTE. Para controlar la velocidad (RPM), 
  * debe llamarse desde un Scheduler o una base de tiempo basada en Systick.
+ * En MODE_MICRO_STEP cada llamada avanza un paso completo (90° eléctricos); los
+ * micropasos intermedios los aplica @ref Stepper_Micro_IRQHandler.
  * * @param hstepper Puntero al handle del motor.
  */
 void Stepper_Step_Sequential(Stepper_t* hstepper);
@@ -81,12 +215,130 @@ void Stepper_Step_Sequential(Stepper_t* hstepper);
  */
 void Stepper_Set_Direction(Stepper_t* hstepper, Step_Dir_t dir);
 
+/* --- Posicionamiento Absoluto --- */
+
+/**
+ * @brief Ordena un movimiento a una posición absoluta.
+ * * @details Fija el sentido y habilita el motor; la ISR de pasos actualiza la posición
+ * y al alcanzar el objetivo termina el movimiento: limpia 'positioning' y 'is_active'
+ * (las bobinas siguen energizadas y el modo Hold sigue activo), activa 'move_done' e
+ * invoca 'on_done'. Un giro continuo posterior solo necesita volver a habilitar el motor.
+ * * @param hstepper Puntero al handle.
+ * @param target Posición absoluta en pasos.
+ * @return Pasos a recorrer (para pasarlos a @ref Stepper_Ramp_Move). 0 si ya está allí.
+ */
+uint32_t Stepper_MoveTo(Stepper_t* hstepper, int32_t target);
+
+/**
+ * @brief Descarta el objetivo en curso sin detener el motor (pasa a giro libre).
+ * @details Para convertir un movimiento absoluto/relativo en un giro continuo antes de
+ * llegar; 'move_done' queda activo y 'on_done' no se invoca.
+ */
+void Stepper_Cancel_Move(Stepper_t* hstepper);
+
+/**
+ * @brief Ordena un movimiento relativo a la posición actual.
+ * @return Pasos a recorrer (para pasarlos a @ref Stepper_Ramp_Move).
+ */
+uint32_t Stepper_MoveRelative(Stepper_t* hstepper, int32_t delta);
+
+/**
+ * @brief Redefine la posición actual (ej. tras un homing) sin mover el motor.
+ */
+void Stepper_Set_Position(Stepper_t* hstepper, int32_t position);
+
+/**
+ * @brief Lectura atómica de la posición absoluta (32 bits).
+ */
+int32_t Stepper_Get_Position(const Stepper_t* hstepper);
+
+/**
+ * @brief Indica si el último movimiento absoluto/relativo terminó.
+ */
+bool Stepper_Is_Done(const Stepper_t* hstepper);
+
+/**
+ * @brief Registra la función a invocar al terminar cada movimiento (NULL para ninguna).
+ * @note Se ejecuta dentro de la ISR de pasos: debe ser breve.
+ */
+void Stepper_Set_Done_Callback(Stepper_t* hstepper, stepper_done_cb_t cb);
+
+/**
+ * @brief Configura la reducción de corriente en reposo (modo Hold).
+ * * @details Transcurridos 'timeout' ticks de @ref Stepper_Hold_Service sin pasos, las
+ * fases energizadas se trocean (chopper) para entregar 'duty'/256 de la corriente
+ * nominal. El eje conserva su posición y el siguiente paso restablece la corriente plena.
+ * * @param hstepper Puntero al handle.
+ * @param timeout Ticks de servicio en reposo antes de reducir (0 desactiva el modo Hold).
+ * @param duty Fracción de corriente de retención (ej. 64 = 25%).
+ */
+void Stepper_Hold_Config(Stepper_t* hstepper, uint16_t timeout, uint8_t duty);
+
+/**
+ * @brief Servicio del modo Hold. Debe llamarse a tasa fija (ej. desde una ISR de 5kHz).
+ * * @details En modos Full/Half genera el troceado por software (una escritura por
+ * puerto solo cuando cambia el estado). En MODE_MICRO_STEP escala una única vez los
+ * ciclos de trabajo PWM y luego no vuelve a escribir.
+ * @note Debe ejecutarse en el mismo nivel de prioridad que los pasos (otra ISR del Timer).
+ */
+void Stepper_Hold_Service(Stepper_t* hstepper);
+
 /**
  * @brief Detiene el motor y fuerza un estado de baja potencia.
- * * @details Deshabilita el flag 'is_active' y pone todas las bobinas en estado LOW.
+ * * @details Deshabilita el flag 'is_active', descarta un objetivo pendiente y pone todas
+ * las bobinas en estado LOW.
  * Es una medida de protección térmica necesaria para el integrado ULN2003.
  * * @param hstepper Puntero al handle.
  */
 void Stepper_Stop(Stepper_t* hstepper);
 
+/* --- API del Generador de Rampas --- */
+
+/**
+ * @brief Precalcula los parámetros del perfil de velocidad.
+ * * @details Es el único punto con divisiones (intervalos de arranque y crucero).
+ * @param hramp Puntero al generador.
+ * @param start_sps Velocidad de arranque en pasos/s (debe estar bajo la frecuencia de pull-in).
+ * Valores menores que @ref STEPPER_RAMP_MIN_SPS se elevan a ese mínimo.
+ * @param max_sps Velocidad de crucero en pasos/s.
+ * @param accel_sps2 Aceleración en pasos/s².
+ */
+void Stepper_Ramp_Init(Stepper_Ramp_t* hramp, uint16_t start_sps, uint16_t max_sps, uint16_t accel_sps2);
+
+/**
+ * @brief Inicia un movimiento de 'steps' pasos (acelera, crucero y frena).
+ * * @details Si el recorrido es corto el perfil resulta triangular: se frena sin
+ * alcanzar la velocidad de crucero.
+ */
+void Stepper_Ramp_Move(Stepper_Ramp_t* hramp, uint32_t steps);
+
+/**
+ * @brief Inicia un giro continuo: acelera y se mantiene en crucero.
+ */
+void Stepper_Ramp_Run(Stepper_Ramp_t* hramp);
+
+/**
+ * @brief Agrega pasos al movimiento en curso sin detenerse (encadenamiento).
+ * * @details Si el motor ya estaba frenando y los nuevos pasos lo permiten, vuelve a
+ * acelerar. Con el generador detenido equivale a @ref Stepper_Ramp_Move.
+ */
+void Stepper_Ramp_Extend(Stepper_Ramp_t* hramp, uint32_t steps);
+
+/**
+ * @brief Solicita una detención con rampa de frenado.
+ */
+void Stepper_Ramp_Stop(Stepper_Ramp_t* hramp);
+
+/**
+ * @brief Indica si el generador tiene pasos pendientes.
+ */
+bool Stepper_Ramp_IsRunning(const Stepper_Ramp_t* hramp);
+
+/**
+ * @brief Avanza el perfil un paso. Debe llamarse desde la ISR, tras emitir el paso.
+ * * @param hramp Puntero al generador.
+ * @return Ticks hasta el próximo paso (sumar al OCR), o 0 si el movimiento terminó.
+ */
+uint16_t Stepper_Ramp_Tick(Stepper_Ramp_t* hramp);
+
 #endif /* STEP_MOTOR_28BYJ48_H_ */
\ No newline at end of file
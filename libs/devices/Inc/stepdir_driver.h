@@ -0,0 +1,91 @@
+/**
+ * @file stepdir_driver.h
+ * @brief Driver para controladores de motor PaP con interfaz STEP/DIR (A4988, DRV8825).
+ * @author Mamani Flores Carlos
+ * @date 2026
+ * * @details El tren de pulsos STEP se genera por hardware con el Timer 1 en Modo CTC
+ * y el pin OC1A (PB1) en modo Toggle: dos coincidencias forman un paso. A velocidad
+ * constante el CPU no interviene; solo se usa la ISR de comparación para aplicar un
+ * cambio de velocidad en un límite de periodo o para contar pasos (opcional).
+ * * @note Ocupa el Timer 1 completo. El pin STEP es fijo (PB1); DIR puede ir en cualquier GPIO.
+ */
+
+#ifndef STEPDIR_DRIVER_H_
+#define STEPDIR_DRIVER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timer1_normal.h"
+#include "step_motor_28BYJ48.h"
+
+/**
+ * @struct StepDir_t
+ * @brief Estado del generador STEP/DIR.
+ */
+typedef struct {
+    volatile uint8_t* dir_port;       /**< Registro PORTx del pin DIR. */
+    uint8_t           dir_pin;        /**< Número de pin DIR (0-7). */
+    t1_prescaler_t    prescaler;      /**< Reloj del Timer 1 mientras hay pulsos. */
+    uint32_t          timer_hz;       /**< Frecuencia del Timer 1 con ese prescaler. */
+    volatile uint16_t pending_top;    /**< Nuevo OCR1A a aplicar en la próxima coincidencia. */
+    volatile bool     update_pending; /**< Hay un cambio de velocidad pendiente. */
+    volatile uint32_t edges_left;     /**< Flancos restantes (2 por paso) en modo con conteo. */
+    volatile bool     counted;        /**< true: se detiene al agotar 'edges_left'. */
+    volatile bool     running;        /**< Tren de pulsos activo. */
+} StepDir_t;
+
+/* --- API Pública --- */
+
+/**
+ * @brief Inicializa el Timer 1 (CTC detenido), el pin STEP (PB1) y el pin DIR.
+ * @param hdrv Puntero a la instancia.
+ * @param dir_port Registro PORTx del pin DIR (ej. &PORTD).
+ * @param dir_pin Número de pin DIR.
+ * @param prescaler Reloj del Timer: define el rango de velocidades
+ * (T1_CLK_8: 16 a 65535 pasos/s; T1_CLK_64: 2 a 65535 pasos/s con menor resolución).
+ */
+void StepDir_Init(StepDir_t* hdrv, volatile uint8_t* dir_port, uint8_t dir_pin, t1_prescaler_t prescaler);
+
+/**
+ * @brief Fija el sentido de giro (pin DIR).
+ * @note Debe cambiarse con el motor detenido: los drivers exigen un tiempo de setup
+ * de DIR antes del flanco de STEP.
+ */
+void StepDir_SetDirection(StepDir_t* hdrv, Step_Dir_t dir);
+
+/**
+ * @brief Cambia la velocidad del tren de pulsos.
+ * @details Única operación con división (pasos/s a ticks). Con el motor en marcha el
+ * nuevo periodo se aplica dentro de la ISR de comparación, justo después de un Match,
+ * para no saltear el TOP del modo CTC.
+ * @param hdrv Puntero a la instancia.
+ * @param sps Velocidad en pasos por segundo.
+ */
+void StepDir_SetSpeed(StepDir_t* hdrv, uint16_t sps);
+
+/**
+ * @brief Inicia un giro continuo. No genera interrupciones mientras la velocidad no cambie.
+ */
+void StepDir_Run(StepDir_t* hdrv);
+
+/**
+ * @brief Emite exactamente 'steps' pasos y se detiene (2 interrupciones por paso).
+ */
+void StepDir_Move(StepDir_t* hdrv, uint32_t steps);
+
+/**
+ * @brief Detiene el tren de pulsos y deja el pin STEP en LOW.
+ */
+void StepDir_Stop(StepDir_t* hdrv);
+
+/**
+ * @brief Indica si el tren de pulsos está activo.
+ */
+bool StepDir_IsRunning(const StepDir_t* hdrv);
+
+/**
+ * @brief Manejador de la coincidencia. Debe llamarse desde ISR(TIMER1_COMPA_vect).
+ */
+void StepDir_IRQHandler(StepDir_t* hdrv);
+
+#endif /* STEPDIR_DRIVER_H_ */
@@ -0,0 +1,103 @@
+/**
+ * @file stepper_planner.h
+ * @brief Planificador de movimiento coordinado para N motores paso a paso.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ * * @details Permite mover varias instancias de Stepper_t en línea recta (interpolación
+ * lineal) desde una única interrupción de Timer. El eje con más pasos (eje dominante)
+ * marca el ritmo y el resto se reparte con el algoritmo de Bresenham, usando solo sumas
+ * y comparaciones enteras. Los segmentos se encolan y el perfil de velocidad
+ * (Stepper_Ramp_t) se encadena entre ellos sin detenerse.
+ */
+
+#ifndef STEPPER_PLANNER_H_
+#define STEPPER_PLANNER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "step_motor_28BYJ48.h"
+
+/** * @name Configuración del Planificador
+ * @{
+ */
+
+/** @brief Cantidad máxima de ejes coordinados por planificador. */
+#ifndef PLANNER_MAX_AXES
+#define PLANNER_MAX_AXES        3
+#endif
+
+/** @brief Longitud de la cola de segmentos (potencia de 2). */
+#ifndef PLANNER_QUEUE_LEN
+#define PLANNER_QUEUE_LEN       8
+#endif
+
+/** @} */
+
+/**
+ * @struct Planner_Segment_t
+ * @brief Movimiento lineal precalculado al encolarse.
+ */
+typedef struct {
+    uint16_t steps[PLANNER_MAX_AXES]; /**< Pasos absolutos por eje. */
+    uint16_t events;                  /**< Pasos del eje dominante (duración del segmento). */
+    uint8_t  dir_mask;                /**< Bit i = 1: eje i en sentido STEP_CCW. */
+    bool     stop_before;             /**< Algún eje invierte su sentido: exige detenerse antes. */
+} Planner_Segment_t;
+
+/**
+ * @struct Stepper_Planner_t
+ * @brief Estado del planificador (cola, segmento en curso y perfil de velocidad).
+ */
+typedef struct {
+    Stepper_t*          axis[PLANNER_MAX_AXES];      /**< Motores coordinados. */
+    uint8_t             n_axes;                      /**< Ejes en uso. */
+    Stepper_Ramp_t      ramp;                        /**< Perfil de velocidad del eje dominante. */
+
+    Planner_Segment_t   queue[PLANNER_QUEUE_LEN];    /**< Cola circular de segmentos. */
+    volatile uint8_t    head;                        /**< Próxima posición a escribir. */
+    volatile uint8_t    tail;                        /**< Próximo segmento a ejecutar. */
+    bool                chain_open;                  /**< La rampa en curso admite más segmentos. */
+    uint8_t             last_dir;                    /**< Sentido del último segmento encolado. */
+    uint8_t             last_moving;                 /**< Ejes que se mueven en el último segmento. */
+
+    Planner_Segment_t   current;                     /**< Copia del segmento en ejecución. */
+    uint16_t            error[PLANNER_MAX_AXES];     /**< Acumuladores de Bresenham. */
+    uint16_t            step_index;                  /**< Pasos emitidos del segmento actual. */
+    bool                busy;                        /**< Hay un segmento en ejecución. */
+} Stepper_Planner_t;
+
+/* --- API Pública --- */
+
+/**
+ * @brief Asocia los motores al planificador y configura el perfil de velocidad.
+ * @param hplanner Puntero al planificador.
+ * @param axes Arreglo de punteros a motores ya inicializados con Stepper_Init.
+ * @param n_axes Cantidad de ejes (1 a PLANNER_MAX_AXES).
+ * @param start_sps Velocidad de arranque del eje dominante (pasos/s).
+ * @param max_sps Velocidad de crucero del eje dominante (pasos/s).
+ * @param accel_sps2 Aceleración del eje dominante (pasos/s²).
+ */
+void Planner_Init(Stepper_Planner_t* hplanner, Stepper_t* axes[], uint8_t n_axes,
+                  uint16_t start_sps, uint16_t max_sps, uint16_t accel_sps2);
+
+/**
+ * @brief Encola un movimiento lineal relativo.
+ * @param hplanner Puntero al planificador.
+ * @param delta Pasos con signo por eje (positivo = STEP_CW), un valor por eje.
+ * @return false si la cola está llena (reintentar más tarde).
+ */
+bool Planner_Enqueue(Stepper_Planner_t* hplanner, const int16_t delta[]);
+
+/**
+ * @brief Indica si no quedan segmentos en ejecución ni en cola.
+ */
+bool Planner_IsIdle(const Stepper_Planner_t* hplanner);
+
+/**
+ * @brief Emite el siguiente paso coordinado. Debe llamarse desde la ISR del Timer.
+ * @return Ticks hasta el próximo paso (sumar al OCR), o 0 si no hay movimiento.
+ * @note Con retorno 0 la aplicación debe re-armar la alarma con un intervalo de sondeo.
+ */
+uint16_t Planner_IRQHandler(Stepper_Planner_t* hplanner);
+
+#endif /* STEPPER_PLANNER_H_ */
@@ -0,0 +1,87 @@
+/**
+ * @file ws2812_driver.h
+ * @brief Driver para tiras de LEDs direccionables WS2812 / WS2812B (NeoPixel).
+ * @author Mamani Flores Carlos
+ * @date 2026
+ * * @details El protocolo es un único hilo a 800kHz: cada bit dura 1.25µs (20 ciclos a
+ * 16MHz) y se distingue por el ancho del pulso en HIGH. El bucle de transmisión está
+ * escrito en ensamblador con la cuenta de ciclos de cada instrucción, ya que el
+ * compilador no garantiza una temporización fija.
+ * * @note Las interrupciones se bloquean solo mientras se envía un LED (24 bits, ~30µs)
+ * y se restauran entre uno y otro: el Systick y el resto de las ISR se atienden entre
+ * píxeles. Una ISR que demore más que el tiempo de reset de la tira (50µs en WS2812,
+ * 280µs en WS2812B) corta la trama y los LEDs siguientes se refrescan en la próxima.
+ */
+
+#ifndef WS2812_DRIVER_H_
+#define WS2812_DRIVER_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+
+/** @brief Bytes por LED en el buffer (orden de transmisión G, R, B). */
+#define WS2812_BYTES_PER_LED    3U
+
+/**
+ * @brief Tiempo mínimo en LOW entre dos tramas para que la tira las acepte (µs).
+ * @details Valor del WS2812B; cubre también al WS2812 original (50µs).
+ */
+#define WS2812_RESET_US         280U
+
+/**
+ * @struct WS2812_t
+ * @brief Pin de datos de una tira.
+ */
+typedef struct {
+    volatile uint8_t* port; /**< Registro PORTx de la línea de datos. */
+    uint8_t           mask; /**< Máscara del pin (1 << pin). */
+} WS2812_t;
+
+/* --- API Pública --- */
+
+/**
+ * @brief Configura el pin de datos como salida en LOW.
+ * @param strip Puntero a la instancia.
+ * @param port Registro PORTx (ej. &PORTD).
+ * @param pin Número de pin (0-7).
+ */
+void WS2812_Init(WS2812_t* strip, volatile uint8_t* port, uint8_t pin);
+
+/**
+ * @brief Carga un color en el buffer empaquetado (orden GRB de la tira).
+ * @param grb Buffer de @ref WS2812_BYTES_PER_LED bytes por LED.
+ * @param index Posición del LED en la tira.
+ */
+static inline void WS2812_Set_Pixel(uint8_t* grb, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t* p = grb + index * WS2812_BYTES_PER_LED;
+    p[0] = g;
+    p[1] = r;
+    p[2] = b;
+}
+
+/**
+ * @brief Escala el brillo del buffer en el lugar (valor * (brightness + 1) / 256).
+ * @details Se ejecuta fuera de la transmisión, un producto de 8x8 bits por byte; 255
+ * deja el buffer intacto. Es destructiva: el color original debe regenerarse para
+ * volver a subir el brillo.
+ * @param grb Buffer empaquetado.
+ * @param count Cantidad de LEDs.
+ * @param brightness Factor de brillo (0-255).
+ */
+void WS2812_Scale(uint8_t* grb, uint16_t count, uint8_t brightness);
+
+/**
+ * @brief Transmite el buffer completo a la tira.
+ * @details Bloqueante: ~30µs por LED más la latencia de las ISR atendidas entre píxeles.
+ * Entre dos llamadas debe transcurrir al menos @ref WS2812_RESET_US (un refresco desde
+ * una tarea del Systick a 1ms o más lo cumple).
+ * @param strip Puntero a la instancia.
+ * @param grb Buffer empaquetado.
+ * @param count Cantidad de LEDs.
+ * @note Los demás pines del mismo puerto se preservan: su estado se lee al comenzar cada
+ * LED, con las interrupciones ya bloqueadas, así que una ISR puede modificarlos entre
+ * píxeles.
+ */
+void WS2812_Show(const WS2812_t* strip, const uint8_t* grb, uint16_t count);
+
+#endif /* WS2812_DRIVER_H_ */
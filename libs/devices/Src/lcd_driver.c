@@ -7,6 +7,12 @@
  * para garantizar la independencia del hardware mientras mantiene la eficiencia del acceso 
  * directo. Los tiempos de delay han sido validados mediante analizador lógico para asegurar 
  * compatibilidad con clones del controlador original y robustez ante cables largos.
+ *
+ * Throughput estimado (16MHz, sin medir sobre hardware):
+ * | Perfil                  | Tiempo por byte                         | Bytes/s   |
+ * | :---------------------- | :-------------------------------------- | :-------- |
+ * | Retardos fijos (sin R/W)| 2 x (150 + 200)µs + 100µs + 2ms = 2.8ms | ~357      |
+ * | Busy Flag (con R/W)     | ~6µs de bus + ~43µs del controlador     | ~20.000   |
  */
 
 #ifndef F_CPU
@@ -25,6 +31,22 @@
  */
 static LCD_Config_t _lcd;
 
+/** @brief true: se consulta el Busy Flag; false: perfil de retardos fijos. */
+static bool lcd_busy_mode = false;
+
+/* --- Estado del Framebuffer --- */
+
+/** @brief Dirección DDRAM desconocida (tras escribir en CGRAM o antes del primer envío). */
+#define LCD_ADDR_UNKNOWN  0xFF
+
+static bool    lcd_fb_mode = false;                          /**< Modo framebuffer activo. */
+static char    lcd_fb[LCD_FB_MAX_ROWS][LCD_FB_MAX_COLS];     /**< Contenido deseado de la DDRAM. */
+static uint8_t lcd_fb_dirty[(LCD_FB_MAX_ROWS * LCD_FB_MAX_COLS + 7) / 8]; /**< 1 bit por celda. */
+static uint8_t lcd_fb_pending = 0;                           /**< Celdas marcadas. */
+static uint8_t lcd_fb_row = 0, lcd_fb_col = 0;               /**< Cursor del framebuffer. */
+static uint8_t lcd_scan_row = 0, lcd_scan_col = 0;           /**< Próxima celda a revisar en el volcado. */
+static uint8_t lcd_hw_addr = LCD_ADDR_UNKNOWN;               /**< Dirección actual del contador DDRAM. */
+
 /* --- Funciones Privadas (Static) --- */
 
 /**
@@ -34,6 +56,14 @@ static LCD_Config_t _lcd;
  * @note Basado en validaciones con analizador lógico para garantizar estabilidad HMI.
  */
 static void LCD_PulseEnable(void) {
+    if (lcd_busy_mode) {
+        /* Tiempos mínimos del HD44780: PWEH >= 450ns, tcycE >= 1000ns */
+        SET_BIT(*_lcd.port_en, _lcd.pin_en);
+        _delay_us(1);
+        CLR_BIT(*_lcd.port_en, _lcd.pin_en);
+        _delay_us(1);
+        return;
+    }
     SET_BIT(*_lcd.port_en, _lcd.pin_en);
     _delay_us(150);  /* Tiempo en alto (Data Setup Time) */
     CLR_BIT(*_lcd.port_en, _lcd.pin_en);
@@ -54,12 +84,73 @@ static void LCD_SendNibble(uint8_t nibble) {
     LCD_PulseEnable();
 }
 
+/**
+ * @brief Espera a que el controlador libere el Busy Flag (D7) o se agote el timeout.
+ * @details
+ * 1. Bus de datos como entrada (DDRx = PORTx - 1) con pull-up en D7: si el LCD no
+ * maneja la línea (R/W a GND), D7 se lee siempre en 1 y el timeout lo detecta.
+ * 2. RS = 0, R/W = 1: cada lectura en 4 bits son dos pulsos de Enable; el Busy Flag
+ * viene en el primero (tDDR <= 360ns) y el segundo (contador de direcciones) se descarta.
+ * 3. Al agotarse @ref LCD_BUSY_TIMEOUT_POLLS el driver pasa al perfil de retardos fijos.
+ */
+static void LCD_WaitBusy(void) {
+    volatile uint8_t* pin_d7 = _lcd.port_d7 - 2;   /* PINx = PORTx - 2 */
+    bool busy;
+    uint16_t polls = LCD_BUSY_TIMEOUT_POLLS;
+
+    CLR_BIT(*(_lcd.port_d4 - 1), _lcd.pin_d4);
+    CLR_BIT(*(_lcd.port_d5 - 1), _lcd.pin_d5);
+    CLR_BIT(*(_lcd.port_d6 - 1), _lcd.pin_d6);
+    CLR_BIT(*(_lcd.port_d7 - 1), _lcd.pin_d7);
+    SET_BIT(*_lcd.port_d7, _lcd.pin_d7);
+
+    CLR_BIT(*_lcd.port_rs, _lcd.pin_rs);
+    SET_BIT(*_lcd.port_rw, _lcd.pin_rw);
+
+    do {
+        SET_BIT(*_lcd.port_en, _lcd.pin_en);
+        _delay_us(1);
+        busy = BIT_IS_SET(*pin_d7, _lcd.pin_d7);
+        CLR_BIT(*_lcd.port_en, _lcd.pin_en);
+        _delay_us(1);
+        SET_BIT(*_lcd.port_en, _lcd.pin_en);   /* Nibble bajo: AC3..AC0 */
+        _delay_us(1);
+        CLR_BIT(*_lcd.port_en, _lcd.pin_en);
+        _delay_us(1);
+    } while (busy && --polls);
+
+    CLR_BIT(*_lcd.port_rw, _lcd.pin_rw);
+
+    SET_BIT(*(_lcd.port_d4 - 1), _lcd.pin_d4);
+    SET_BIT(*(_lcd.port_d5 - 1), _lcd.pin_d5);
+    SET_BIT(*(_lcd.port_d6 - 1), _lcd.pin_d6);
+    SET_BIT(*(_lcd.port_d7 - 1), _lcd.pin_d7);
+
+    /* Timeout: R/W ausente o mal cableado. Los retardos fijos cubren la operación en curso */
+    if (busy) {
+        lcd_busy_mode = false;
+        _delay_ms(2);
+    }
+}
+
 /**
  * @brief Envía un byte completo al controlador dividiéndolo en dos nibbles.
+ * @details Con Busy Flag la espera ocurre antes del envío, así el tiempo de proceso del
+ * controlador se solapa con el código que prepara el próximo byte.
  * @param byte El comando o dato a enviar.
  * @param is_data Flag de selección: 1 para datos (RS High), 0 para comandos (RS Low).
  */
 static void LCD_SendByte(uint8_t byte, uint8_t is_data) {
+    if (lcd_busy_mode) {
+        LCD_WaitBusy();
+        if (lcd_busy_mode) {
+            (is_data) ? SET_BIT(*_lcd.port_rs, _lcd.pin_rs) : CLR_BIT(*_lcd.port_rs, _lcd.pin_rs);
+            LCD_SendNibble(byte >> 4);
+            LCD_SendNibble(byte & 0x0F);
+            return;
+        }
+    }
+
     (is_data) ? SET_BIT(*_lcd.port_rs, _lcd.pin_rs) : CLR_BIT(*_lcd.port_rs, _lcd.pin_rs);
     
     LCD_SendNibble(byte >> 4);   /* Envía los 4 bits más significativos primero */
@@ -68,6 +159,44 @@ static void LCD_SendByte(uint8_t byte, uint8_t is_data) {
     _delay_ms(2);                /* Retardo de seguridad para asegurar el procesamiento interno */
 }
 
+/**
+ * @brief Dirección DDRAM (sin el bit 7 de comando) de una celda.
+ */
+static uint8_t LCD_Address(uint8_t row, uint8_t col) {
+    if (_lcd.type == LCD_20X4) {
+        /* Mapeo de direcciones DDRAM para displays de 4 filas */
+        static const uint8_t row_offsets[] = {0x00, 0x40, 0x14, 0x54};
+        return row_offsets[row & 0x03] + col;
+    }
+    /* Mapeo estándar para 16x2 */
+    return (row == 0) ? col : (0x40 + col);
+}
+
+/** @brief Filas y columnas visibles del modelo configurado. */
+static inline uint8_t LCD_Rows(void) { return (_lcd.type == LCD_20X4) ? 4 : 2; }
+static inline uint8_t LCD_Cols(void) { return (_lcd.type == LCD_20X4) ? 20 : 16; }
+
+/**
+ * @brief Escribe un carácter en el framebuffer y avanza el cursor.
+ * @details Fuera de la pantalla el carácter se descarta (recorte de línea). Si la celda
+ * ya contiene ese carácter no se marca: reescribir un campo sin cambios no cuesta bus.
+ */
+static void LCD_FB_Put(char c) {
+    uint8_t row = lcd_fb_row, col = lcd_fb_col;
+    if (row >= LCD_Rows() || col >= LCD_Cols()) return;
+
+    lcd_fb_col++;
+    if (lcd_fb[row][col] == c) return;
+    lcd_fb[row][col] = c;
+
+    uint8_t cell = row * LCD_FB_MAX_COLS + col;
+    uint8_t bit  = (1 << (cell & 0x07));
+    if (!(lcd_fb_dirty[cell >> 3] & bit)) {
+        lcd_fb_dirty[cell >> 3] |= bit;
+        lcd_fb_pending++;
+    }
+}
+
 /* --- Implementación de la API Pública --- */
 
 /**
@@ -78,6 +207,10 @@ static void LCD_SendByte(uint8_t byte, uint8_t is_data) {
  */
 void LCD_Init(const LCD_Config_t *config) {
     _lcd = *config; /* Copia profunda de la configuración a la instancia local estática */
+    lcd_fb_mode = false; /* La secuencia de arranque siempre escribe directo al bus */
+    lcd_busy_mode = false; /* El Busy Flag no es válido hasta fijar el modo 4 bits */
+
+    if (_lcd.port_rw) CLR_BIT(*_lcd.port_rw, _lcd.pin_rw); /* R/W en escritura */
 
     _delay_ms(150); /* Tiempo de espera tras el encendido para estabilización de VDD */
 
@@ -87,6 +220,9 @@ void LCD_Init(const LCD_Config_t *config) {
     LCD_SendNibble(0x03);
     LCD_SendNibble(0x02); /* Configura definitivamente el bus en modo 4 bits */
 
+    /* Desde aquí el controlador responde lecturas en 4 bits: se usa el Busy Flag si hay R/W */
+    lcd_busy_mode = (_lcd.port_rw != 0);
+
     /* Configuración de parámetros: Interfaz 4-bits, 2 líneas (o más), fuente 5x8 */
     LCD_SendByte(0x28, 0); 
     /* Configuración visual: Display ON, Cursor invisible por defecto */
@@ -96,11 +232,24 @@ void LCD_Init(const LCD_Config_t *config) {
 
 /**
  * @brief Limpia la memoria de video (DDRAM) y resetea el cursor.
- * @note Esta operación es bloqueante por ~5ms debido a la latencia del controlador.
+ * @note Con retardos fijos es bloqueante por ~5ms debido a la latencia del controlador.
+ * Con Busy Flag retorna al enviar el comando y la próxima escritura espera los ~1.52ms.
  */
 void LCD_Clear(void) {
+    if (lcd_fb_mode) {
+        /* Framebuffer: solo se marcan las celdas que no estaban en blanco */
+        for (uint8_t r = 0; r < LCD_Rows(); r++) {
+            lcd_fb_row = r;
+            lcd_fb_col = 0;
+            for (uint8_t c = 0; c < LCD_Cols(); c++) LCD_FB_Put(' ');
+        }
+        lcd_fb_row = 0;
+        lcd_fb_col = 0;
+        return;
+    }
     LCD_SendByte(0x01, 0);
-    _delay_ms(5); 
+    if (!lcd_busy_mode) _delay_ms(5); /* Con Busy Flag la próxima escritura espera lo necesario */
+    lcd_hw_addr = 0;
 }
 
 /**
@@ -109,16 +258,14 @@ void LCD_Clear(void) {
  * @param col Columna (0-15 o 0-19 según el tipo definido en la inicialización).
  */
 void LCD_SetCursor(uint8_t row, uint8_t col) {
-    uint8_t addr;
-    if (_lcd.type == LCD_20X4) {
-        /* Mapeo de direcciones DDRAM para displays de 4 filas */
-        uint8_t row_offsets[] = {0x00, 0x40, 0x14, 0x54};
-        addr = 0x80 + row_offsets[row] + col;
-    } else {
-        /* Mapeo estándar para 16x2 */
-        addr = (row == 0) ? (0x80 + col) : (0xC0 + col);
+    if (lcd_fb_mode) {
+        lcd_fb_row = row;
+        lcd_fb_col = col;
+        return;
     }
-    LCD_SendByte(addr, 0);
+    uint8_t addr = LCD_Address(row, col);
+    LCD_SendByte(0x80 | addr, 0);
+    lcd_hw_addr = addr;
 }
 
 /**
@@ -126,7 +273,12 @@ void LCD_SetCursor(uint8_t row, uint8_t col) {
  * @param str Puntero a la cadena (string) terminada en null almacenada en RAM.
  */
 void LCD_Print(const char *str) {
+    if (lcd_fb_mode) {
+        while (*str) LCD_FB_Put(*str++);
+        return;
+    }
     while (*str) LCD_SendByte((uint8_t)(*str++), 1);
+    lcd_hw_addr = LCD_ADDR_UNKNOWN;
 }
 
 /**
@@ -134,7 +286,12 @@ void LCD_Print(const char *str) {
  * @param data Byte de datos o carácter ASCII.
  */
 void LCD_WriteChar(char data) {
+    if (lcd_fb_mode) {
+        LCD_FB_Put(data);
+        return;
+    }
     LCD_SendByte((uint8_t)data, 1);
+    lcd_hw_addr = LCD_ADDR_UNKNOWN;
 }
 
 /**
@@ -165,4 +322,79 @@ void LCD_CreateCustomChar(uint8_t location, uint8_t charmap[]) {
     for (uint8_t i = 0; i < 8; i++) {
         LCD_SendByte(charmap[i], 1);
     }
+    /* El contador de direcciones quedó apuntando a la CGRAM */
+    lcd_hw_addr = LCD_ADDR_UNKNOWN;
+}
+
+bool LCD_IsBusyFlagMode(void) {
+    return lcd_busy_mode;
+}
+
+/* --- Framebuffer (Shadow DDRAM) --- */
+
+/**
+ * @brief Cambia de modo. Al activarlo, limpia pantalla y copia para que coincidan.
+ */
+void LCD_FB_Enable(bool enable) {
+    if (enable && !lcd_fb_mode) {
+        for (uint8_t r = 0; r < LCD_FB_MAX_ROWS; r++) {
+            for (uint8_t c = 0; c < LCD_FB_MAX_COLS; c++) lcd_fb[r][c] = ' ';
+        }
+        for (uint8_t i = 0; i < sizeof(lcd_fb_dirty); i++) lcd_fb_dirty[i] = 0;
+        lcd_fb_pending = 0;
+        lcd_fb_row = lcd_fb_col = 0;
+        lcd_scan_row = lcd_scan_col = 0;
+
+        LCD_Clear();    /* Aún en modo directo: deja lcd_hw_addr en 0 */
+    }
+    lcd_fb_mode = enable;
+}
+
+/**
+ * @brief Volcado incremental.
+ * @details
+ * 1. Se revisa cada celda a partir de la posición guardada (round-robin), así un
+ * presupuesto chico no posterga siempre las últimas filas.
+ * 2. Una celda cuya dirección coincide con el contador DDRAM del controlador (la
+ * siguiente a la última escrita) cuesta 1 byte; si no, 2 (comando de dirección + dato).
+ * 3. Si el costo de la celda supera el presupuesto restante, la llamada termina y la
+ * próxima retoma exactamente en esa celda. Con menos de 2 bytes una celda con salto de
+ * dirección nunca entraría y el volcado no avanzaría: el presupuesto se eleva a 2.
+ */
+bool LCD_FB_Flush(uint8_t max_bytes) {
+    if (max_bytes < LCD_FB_MIN_BUDGET) max_bytes = LCD_FB_MIN_BUDGET;
+
+    uint8_t rows = LCD_Rows();
+    uint8_t cols = LCD_Cols();
+
+    while (lcd_fb_pending) {
+        uint8_t row  = lcd_scan_row;
+        uint8_t col  = lcd_scan_col;
+        uint8_t cell = row * LCD_FB_MAX_COLS + col;
+        uint8_t bit  = (1 << (cell & 0x07));
+
+        if (lcd_fb_dirty[cell >> 3] & bit) {
+            uint8_t addr = LCD_Address(row, col);
+            uint8_t cost = (addr == lcd_hw_addr) ? 1 : 2;
+            if (cost > max_bytes) return false;
+
+            if (cost == 2) LCD_SendByte(0x80 | addr, 0);
+            LCD_SendByte((uint8_t)lcd_fb[row][col], 1);
+
+            lcd_hw_addr = addr + 1;   /* Auto-incremento del HD44780 */
+            lcd_fb_dirty[cell >> 3] &= ~bit;
+            lcd_fb_pending--;
+            max_bytes -= cost;
+        }
+
+        if (++lcd_scan_col >= cols) {
+            lcd_scan_col = 0;
+            if (++lcd_scan_row >= rows) lcd_scan_row = 0;
+        }
+    }
+    return true;
+}
+
+bool LCD_FB_IsDirty(void) {
+    return lcd_fb_pending != 0;
 }
\ No newline at end of file
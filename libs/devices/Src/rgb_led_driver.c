@@ -9,8 +9,40 @@
  * callbacks para garantizar la portabilidad absoluta entre diferentes MCUs.
  */
 
+#include <avr/pgmspace.h>
 #include "rgb_led_driver.h"
 
+/**
+ * @brief Corrección Gamma 2.2 en Q8.4 (4080 * (i/255)^2.2) en FLASH.
+ * @details Los 4 bits fraccionarios alimentan el dithering temporal; sin dithering se
+ * redondean a 8 bits.
+ */
+static const uint16_t RGB_GAMMA_TABLE[256] PROGMEM = {
+       0,    0,    0,    0,    0,    1,    1,    1,    2,    3,    3,    4,    5,    6,    7,    8,
+       9,   11,   12,   13,   15,   17,   19,   21,   23,   25,   27,   29,   32,   34,   37,   40,
+      42,   45,   48,   52,   55,   58,   62,   66,   69,   73,   77,   81,   85,   90,   94,   99,
+     104,  108,  113,  118,  123,  129,  134,  140,  145,  151,  157,  163,  169,  175,  182,  188,
+     195,  202,  209,  216,  223,  230,  237,  245,  253,  260,  268,  276,  284,  293,  301,  310,
+     318,  327,  336,  345,  355,  364,  373,  383,  393,  403,  413,  423,  433,  444,  454,  465,
+     476,  487,  498,  509,  520,  532,  543,  555,  567,  579,  591,  604,  616,  629,  642,  655,
+     668,  681,  694,  708,  721,  735,  749,  763,  777,  791,  806,  820,  835,  850,  865,  880,
+     896,  911,  927,  942,  958,  974,  991, 1007, 1023, 1040, 1057, 1074, 1091, 1108, 1125, 1143,
+    1161, 1178, 1196, 1214, 1233, 1251, 1270, 1288, 1307, 1326, 1345, 1365, 1384, 1404, 1423, 1443,
+    1463, 1484, 1504, 1524, 1545, 1566, 1587, 1608, 1629, 1651, 1672, 1694, 1716, 1738, 1760, 1782,
+    1805, 1827, 1850, 1873, 1896, 1919, 1943, 1966, 1990, 2014, 2038, 2062, 2087, 2111, 2136, 2160,
+    2185, 2211, 2236, 2261, 2287, 2313, 2338, 2365, 2391, 2417, 2444, 2470, 2497, 2524, 2551, 2579,
+    2606, 2634, 2662, 2690, 2718, 2746, 2774, 2803, 2832, 2861, 2890, 2919, 2949, 2978, 3008, 3038,
+    3068, 3098, 3128, 3159, 3190, 3220, 3251, 3283, 3314, 3345, 3377, 3409, 3441, 3473, 3505, 3538,
+    3571, 3603, 3636, 3669, 3703, 3736, 3770, 3804, 3838, 3872, 3906, 3941, 3975, 4010, 4045, 4080
+};
+
+/**
+ * @brief Producto a * b / 255 aproximado con un desplazamiento (exacto en 0 y 255).
+ */
+static inline uint8_t RGB_Scale8(uint8_t a, uint8_t b) {
+    return (uint8_t)(((uint16_t)a * (b + 1)) >> 8);
+}
+
 /**
  * @brief Inicializa la estructura de control y vincula el hardware.
  * * @details Realiza el "binding" de las funciones de PWM de bajo nivel con el
@@ -19,24 +51,41 @@
  * * @param led    Puntero al objeto de estado del LED.
  * @param type   Arquitectura del LED (@ref rgb_type_t).
  * @param max_br Límite de intensidad (0-255).
- * @param f_red  Puntero a la función PWM para el canal Rojo.
- * @param f_green Puntero a la función PWM para el canal Verde.
- * @param f_blue Puntero a la función PWM para el canal Azul.
+ * @param ch_red   Registro OCR del canal Rojo.
+ * @param ch_green Registro OCR del canal Verde.
+ * @param ch_blue  Registro OCR del canal Azul.
  */
 void RGB_Init(RGB_LED_t *led, rgb_type_t type, uint8_t max_br, 
-              pwm_set_duty_t f_red, pwm_set_duty_t f_green, pwm_set_duty_t f_blue) {
+              pwm8_channel_t ch_red, pwm8_channel_t ch_green, pwm8_channel_t ch_blue) {
     
-    /* Validación de puntero de instancia */
-    if (!led) return;
+    /* Validación de puntero de instancia y de los tres canales PWM */
+    if (!led || !ch_red || !ch_green || !ch_blue) return;
 
-    /* Inyección de dependencias: Vinculación de funciones de Capa 1 */
-    led->set_red   = f_red;
-    led->set_green = f_green;
-    led->set_blue  = f_blue;
+    /* Inyección de dependencias: Vinculación de los registros OCR de Capa 1 */
+    led->ch_red   = ch_red;
+    led->ch_green = ch_green;
+    led->ch_blue  = ch_blue;
     
     /* Configuración de parámetros de operación y límites */
     led->type = type;
     led->max_brightness = max_br;
+
+    /* Estado HSV por defecto: Rojo puro a brillo completo (la salida sigue apagada) */
+    led->hue = 0;
+    led->saturation = 255;
+    led->value = 255;
+
+    /* Dithering desactivado hasta que la aplicación conecte la ISR de Overflow */
+    led->dither = false;
+    for (uint8_t i = 0; i < 3; i++) {
+        led->dither_frac[i] = 0;
+        led->dither_acc[i]  = 0;
+    }
+
+    /* Escritura inmediata hasta que la instancia se agrupe con RGB_Batch_Init */
+    led->batched   = false;
+    led->staged    = false;
+    led->committed = false;
     
     /** * @note Se invoca la actualización inicial para asegurar que el hardware 
      * refleje el estado de 'apagado' definido en la estructura. 
@@ -44,12 +93,71 @@ void RGB_Init(RGB_LED_t *led, rgb_type_t type, uint8_t max_br,
     RGB_Set_Color_Direct(led, 0, 0, 0); 
 }
 
+/**
+ * @brief Escribe los tres OCR y persiste el color (sin clamping).
+ * @details Debe ejecutarse con interrupciones bloqueadas: así la ISR de dithering nunca
+ * mezcla partes de dos colores y una interrupción larga no separa las escrituras.
+ */
+static void RGB_Output(RGB_LED_t *led, uint8_t r, uint8_t g, uint8_t b,
+                       uint8_t fr, uint8_t fg, uint8_t fb) {
+
+    if (led->type == RGB_ANODE_COMMON) {
+        /** * Ánodo Común: Lógica Invertida. 
+         * Un valor de 0 en el registro PWM produce brillo máximo, 
+         * por lo que se resta el valor deseado del rango máximo (255).
+         */
+        PWM_WRITE(led->ch_red,   255 - r);
+        PWM_WRITE(led->ch_green, 255 - g);
+        PWM_WRITE(led->ch_blue,  255 - b);
+    } else {
+        /** * Cátodo Común: Lógica Directa. 
+         * El Duty Cycle es directamente proporcional a la intensidad lumínica.
+         */
+        PWM_WRITE(led->ch_red,   r);
+        PWM_WRITE(led->ch_green, g);
+        PWM_WRITE(led->ch_blue,  b);
+    }
+
+    /* Persistencia de estado para telemetría, efectos y dithering */
+    led->current_r = r;
+    led->current_g = g;
+    led->current_b = b;
+
+    led->dither_frac[0] = fr;
+    led->dither_frac[1] = fg;
+    led->dither_frac[2] = fb;
+}
+
+/* --- Estado del Lote (Batch) --- */
+
+static RGB_LED_t *const *rgb_batch       = 0;      /**< Instancias del lote. */
+static uint8_t           rgb_batch_count = 0;
+static volatile bool     rgb_batch_pending = false; /**< Commit esperando el próximo TOP. */
+
+/**
+ * @brief Guarda un color Q8.4 (ya limitado) para el próximo commit.
+ * @details Escribe solo el buffer de preparación: la ISR lee la copia del commit, así
+ * que no hay que esperarla. La sección crítica corta evita que un commit copie un color
+ * a medio escribir (apto para llamarse desde una ISR o con interrupciones bloqueadas).
+ */
+static void RGB_Stage(RGB_LED_t *led, uint16_t r, uint16_t g, uint16_t b) {
+    uint8_t sreg = SREG;
+    cli();
+    led->staged_rgb[0] = r;
+    led->staged_rgb[1] = g;
+    led->staged_rgb[2] = b;
+    led->staged = true;
+    SREG = sreg;
+}
+
 /**
  * @brief Procesa y establece los valores de color en los periféricos.
  * * @details Esta función realiza tres pasos críticos:
  * 1. Clamping: Asegura que los valores no superen el brillo máximo definido.
  * 2. Inversión Lógica: Si el LED es Ánodo Común, invierte el Duty Cycle (255 - valor).
- * 3. Ejecución de Callbacks: Llama a las funciones de hardware inyectadas.
+ * 3. Escritura directa: Un ST sobre cada registro OCR inyectado, los tres dentro de la
+ * misma sección crítica. En una instancia agrupada (@ref RGB_Batch_Init) el color
+ * solo se prepara y se aplica en el próximo commit.
  * * @param led Puntero a la instancia del LED.
  * @param r   Intensidad lógica para el Rojo (0-255).
  * @param g   Intensidad lógica para el Verde (0-255).
@@ -64,28 +172,16 @@ void RGB_Set_Color_Direct(RGB_LED_t *led, uint8_t r, uint8_t g, uint8_t b) {
     if (g > led->max_brightness) g = led->max_brightness;
     if (b > led->max_brightness) b = led->max_brightness;
 
-    /* 2. Procesamiento de Salida y Abstracción de Hardware */
-    if (led->type == RGB_ANODE_COMMON) {
-        /** * Ánodo Común: Lógica Invertida. 
-         * Un valor de 0 en el registro PWM produce brillo máximo, 
-         * por lo que se resta el valor deseado del rango máximo (255).
-         */
-        if(led->set_red)   led->set_red(255 - r);
-        if(led->set_green) led->set_green(255 - g);
-        if(led->set_blue)  led->set_blue(255 - b);
-    } else {
-        /** * Cátodo Común: Lógica Directa. 
-         * El Duty Cycle es directamente proporcional a la intensidad lumínica.
-         */
-        if(led->set_red)   led->set_red(r);
-        if(led->set_green) led->set_green(g);
-        if(led->set_blue)  led->set_blue(b);
+    if (led->batched) {
+        RGB_Stage(led, (uint16_t)r << 4, (uint16_t)g << 4, (uint16_t)b << 4);
+        return;
     }
 
-    /* 3. Persistencia de estado para telemetría o efectos */
-    led->current_r = r;
-    led->current_g = g;
-    led->current_b = b;
+    /* 2 y 3. Un color de 8 bits no tiene parte fraccionaria que modular */
+    uint8_t sreg = SREG;
+    cli();
+    RGB_Output(led, r, g, b, 0, 0, 0);
+    SREG = sreg;
 }
 
 /**
@@ -113,4 +209,254 @@ void RGB_Set_Preset(RGB_LED_t *led, RGB_PresetColor_t color) {
         case COLOR_OFF:     RGB_Set_Color_Direct(led, 0, 0, 0);     break;
         default:                                                    break;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Convierte HSV a RGB, aplica Gamma y escribe los canales.
+ * @details
+ * 1. Sector (hue >> 8) y posición dentro del sector (hue & 0xFF).
+ * 2. Los tres niveles del modelo HSV: p (mínimo), q (bajando) y t (subiendo).
+ * 3. El sector solo elige la permutación de (v, p, q, t): un switch sin comparaciones
+ * de rango ni clamping por canal.
+ * 4. Corrección Gamma por tabla en Q8.4 (una lectura de FLASH por canal).
+ */
+void RGB_Set_HSV(RGB_LED_t *led, uint16_t hue, uint8_t sat, uint8_t val) {
+
+    if (!led) return;
+
+    if (hue >= RGB_HUE_STEPS) hue %= RGB_HUE_STEPS;
+
+    led->hue = hue;
+    led->saturation = sat;
+    led->value = val;
+
+    /* El límite de la instancia escala el brillo (no recorta canales: el tono se conserva) */
+    uint8_t v = RGB_Scale8(val, led->max_brightness);
+    uint8_t f = (uint8_t)hue;
+
+    uint8_t p = RGB_Scale8(v, 255 - sat);
+    uint8_t q = RGB_Scale8(v, 255 - RGB_Scale8(sat, f));
+    uint8_t t = RGB_Scale8(v, 255 - RGB_Scale8(sat, 255 - f));
+
+    uint8_t r, g, b;
+    switch (hue >> 8) {
+        case 0:  r = v; g = t; b = p; break;
+        case 1:  r = q; g = v; b = p; break;
+        case 2:  r = p; g = v; b = t; break;
+        case 3:  r = p; g = q; b = v; break;
+        case 4:  r = t; g = p; b = v; break;
+        default: r = v; g = p; b = q; break;
+    }
+
+    RGB_Set_Color_Fine(led,
+                       pgm_read_word(&RGB_GAMMA_TABLE[r]),
+                       pgm_read_word(&RGB_GAMMA_TABLE[g]),
+                       pgm_read_word(&RGB_GAMMA_TABLE[b]));
+}
+
+void RGB_Set_Hue(RGB_LED_t *led, uint16_t hue) {
+    if (!led) return;
+    RGB_Set_HSV(led, hue, led->saturation, led->value);
+}
+
+void RGB_Set_Brightness(RGB_LED_t *led, uint8_t val) {
+    if (!led) return;
+    RGB_Set_HSV(led, led->hue, led->saturation, val);
+}
+
+/**
+ * @brief Canal que cambia en cada sector: t sube en los pares, q baja en los impares.
+ * @details Los otros dos canales valen v y p durante todo el sector.
+ */
+static const uint8_t RGB_RAMP_CHANNEL[6] = { 1, 0, 2, 1, 0, 2 };
+
+/**
+ * @brief Incrementa el tono con vuelta circular (una resta, sin división).
+ * @details Dentro de un sector solo un canal cambia (la rampa t o q), así que el paso
+ * recalcula ese canal: 2 productos de 8x8, una lectura de la tabla Gamma y un ST al OCR,
+ * con los otros dos canales intactos. Al cruzar de sector, o en una instancia agrupada,
+ * se usa la conversión completa de @ref RGB_Set_HSV. Con paso 1 los extremos de sector
+ * coinciden (t = v al final, q = v al inicio del siguiente): nunca cambian dos canales a
+ * la vez y no hace falta commit para evitar colores intermedios.
+ */
+void RGB_Hue_Step(RGB_LED_t *led, uint16_t step) {
+    if (!led) return;
+
+    uint16_t hue = led->hue + step;
+    if (hue >= RGB_HUE_STEPS) hue -= RGB_HUE_STEPS;
+
+    uint8_t sector = (uint8_t)(hue >> 8);
+    if (led->batched || sector != (uint8_t)(led->hue >> 8)) {
+        RGB_Set_HSV(led, hue, led->saturation, led->value);
+        return;
+    }
+    led->hue = hue;
+
+    /* Misma fórmula que RGB_Set_HSV: t con (255 - f), q con f */
+    uint8_t f = (uint8_t)hue;
+    if (!(sector & 1)) f = 255 - f;
+
+    uint8_t v = RGB_Scale8(led->value, led->max_brightness);
+    uint8_t level = RGB_Scale8(v, 255 - RGB_Scale8(led->saturation, f));
+
+    /* level <= max_brightness y Gamma(x) <= 16x: sin clamping contra el límite Q8.4 */
+    uint16_t fine = pgm_read_word(&RGB_GAMMA_TABLE[level]);
+    uint8_t n, frac;
+    if (led->dither) {
+        n = fine >> 4;
+        frac = fine & 0x0F;
+    } else {
+        n = (fine + 8) >> 4;
+        frac = 0;
+    }
+
+    uint8_t ch = RGB_RAMP_CHANNEL[sector];
+    pwm8_channel_t out = (ch == 0) ? led->ch_red : (ch == 1) ? led->ch_green : led->ch_blue;
+
+    uint8_t sreg = SREG;
+    cli();
+    PWM_WRITE(out, (led->type == RGB_ANODE_COMMON) ? (255 - n) : n);
+    if (ch == 0)      led->current_r = n;
+    else if (ch == 1) led->current_g = n;
+    else              led->current_b = n;
+    led->dither_frac[ch] = frac;
+    SREG = sreg;
+}
+
+/* --- Dithering Temporal --- */
+
+/**
+ * @brief Carga un color Q8.4: parte entera en current_x, fracción en dither_frac.
+ * @details Sin dithering el valor se redondea al entero más cercano. La carga se hace
+ * con interrupciones bloqueadas para que la ISR nunca combine la parte entera de un
+ * color con la fracción de otro.
+ */
+void RGB_Set_Color_Fine(RGB_LED_t *led, uint16_t r, uint16_t g, uint16_t b) {
+
+    if (!led) return;
+
+    uint16_t lim = (uint16_t)led->max_brightness << 4;
+    if (r > lim) r = lim;
+    if (g > lim) g = lim;
+    if (b > lim) b = lim;
+
+    if (led->batched) {
+        RGB_Stage(led, r, g, b);
+        return;
+    }
+
+    uint8_t sreg = SREG;
+    cli();
+    if (led->dither) {
+        RGB_Output(led, r >> 4, g >> 4, b >> 4, r & 0x0F, g & 0x0F, b & 0x0F);
+    } else {
+        RGB_Output(led, (r + 8) >> 4, (g + 8) >> 4, (b + 8) >> 4, 0, 0, 0);
+    }
+    SREG = sreg;
+}
+
+void RGB_Dither_Enable(RGB_LED_t *led, bool enable) {
+
+    if (!led) return;
+
+    uint8_t sreg = SREG;
+    cli();
+
+    led->dither = enable;
+    for (uint8_t i = 0; i < 3; i++) led->dither_acc[i] = 0;
+
+    /* Descarta el "+1" que la ISR pudo haber dejado en los OCR */
+    RGB_Output(led, led->current_r, led->current_g, led->current_b, 0, 0, 0);
+
+    SREG = sreg;
+}
+
+/* --- Actualización por Lotes --- */
+
+void RGB_Batch_Init(RGB_LED_t *const *leds, uint8_t count) {
+    rgb_batch         = leds;
+    rgb_batch_count   = count;
+    rgb_batch_pending = false;
+
+    for (uint8_t i = 0; i < count; i++) {
+        leds[i]->staged    = false;
+        leds[i]->committed = false;
+        leds[i]->batched   = true;
+    }
+}
+
+/**
+ * @brief Copia los colores preparados al buffer del commit. Con interrupciones bloqueadas.
+ */
+static void RGB_Batch_Snapshot(void) {
+    for (uint8_t i = 0; i < rgb_batch_count; i++) {
+        RGB_LED_t *led = rgb_batch[i];
+        if (!led->staged) continue;
+
+        led->commit_rgb[0] = led->staged_rgb[0];
+        led->commit_rgb[1] = led->staged_rgb[1];
+        led->commit_rgb[2] = led->staged_rgb[2];
+        led->committed = true;
+        led->staged    = false;
+    }
+}
+
+/**
+ * @brief Vuelca los colores del commit. Se ejecuta con interrupciones bloqueadas.
+ * @details Costo por instancia con commit: redondeo o separación Q8.4 y tres ST; las
+ * instancias sin cambios solo cuestan la lectura de su bandera.
+ */
+static void RGB_Batch_Apply(void) {
+    for (uint8_t i = 0; i < rgb_batch_count; i++) {
+        RGB_LED_t *led = rgb_batch[i];
+        if (!led->committed) continue;
+
+        uint16_t r = led->commit_rgb[0];
+        uint16_t g = led->commit_rgb[1];
+        uint16_t b = led->commit_rgb[2];
+
+        if (led->dither) {
+            RGB_Output(led, r >> 4, g >> 4, b >> 4, r & 0x0F, g & 0x0F, b & 0x0F);
+        } else {
+            RGB_Output(led, (r + 8) >> 4, (g + 8) >> 4, (b + 8) >> 4, 0, 0, 0);
+        }
+        led->committed = false;
+    }
+}
+
+/**
+ * @brief Aplica de inmediato; absorbe también un commit en TOP aún no tomado por la ISR.
+ */
+void RGB_Commit(void) {
+    uint8_t sreg = SREG;
+    cli();
+    RGB_Batch_Snapshot();
+    RGB_Batch_Apply();
+    rgb_batch_pending = false;
+    SREG = sreg;
+}
+
+void RGB_Commit_At_Top(void) {
+    uint8_t sreg = SREG;
+    cli();
+    RGB_Batch_Snapshot();
+    rgb_batch_pending = true;
+    SREG = sreg;
+}
+
+bool RGB_Commit_IsPending(void) {
+    return rgb_batch_pending;
+}
+
+/**
+ * @brief Aplica el commit pendiente al comienzo del periodo (ISR de Overflow).
+ * @details El TOV se activa en el mismo instante en que los OCR con doble buffer se
+ * cargan; la ISR escribe los valores nuevos al inicio de un periodo y cada Timer los
+ * toma en su BOTTOM siguiente (los de un Timer desfasado, en el suyo).
+ */
+void RGB_Batch_IRQHandler(void) {
+    if (!rgb_batch_pending) return;
+
+    RGB_Batch_Apply();
+    rgb_batch_pending = false;
+}
@@ -7,68 +7,480 @@
  * Utiliza "Inyección de Dependencias" mediante punteros a función, lo que permite:
  * 1. Manejar múltiples servos simultáneamente (instanciación).
  * 2. Ser agnóstico al Timer utilizado (8 o 16 bits).
- * 3. Ejecutar el mapeo de grados a ticks mediante aritmética de precisión sin float.
+ * 3. Ejecutar el mapeo de grados a ticks mediante aritmética de punto fijo, sin float ni división.
+ * 4. Generar trayectorias trapezoidales (velocidad/aceleración limitadas) desde una ISR.
  */
 
 #include "servo_sg90.h"
+#include "timer1_normal.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/** * @name Estructuras internas del Multiplexor
+ * @{
+ */
+
+/**
+ * @brief Ranura de pulso precalculada (flanco de bajada de un servo).
+ * @note El offset se mide en ticks desde el flanco de subida común del grupo.
+ */
+typedef struct {
+    uint16_t          offset; /**< Ancho de pulso en ticks (ordenado ascendentemente). */
+    volatile uint8_t* port;   /**< Registro PORTx del servo. */
+    uint8_t           mask;   /**< Máscara del pin dentro del puerto. */
+} servo_slot_t;
+
+/**
+ * @brief Máscara de subida agrupada por puerto (como máximo PORTB, PORTC y PORTD).
+ */
+typedef struct {
+    volatile uint8_t* port;   /**< Registro PORTx. */
+    uint8_t           mask;   /**< Pines del grupo ubicados en ese puerto. */
+} servo_port_mask_t;
+
+/**
+ * @brief Tabla de planificación de un frame (se usa con doble buffer).
+ */
+typedef struct {
+    servo_slot_t      slot[SERVO_MUX_GROUP_SIZE]; /**< Flancos de bajada ordenados. */
+    servo_port_mask_t rise[3];                    /**< Flancos de subida por puerto. */
+    uint8_t           count;                      /**< Ranuras válidas. */
+    uint8_t           rise_count;                 /**< Puertos distintos del grupo. */
+} servo_table_t;
+
+/**
+ * @brief Estado de un grupo de servos atendido por un canal de comparación.
+ */
+typedef struct {
+    servo_table_t     table[2];                       /**< Doble buffer (ISR / aplicación). */
+    volatile uint8_t  active;                         /**< Índice del buffer usado por la ISR. */
+    volatile uint8_t  pending;                        /**< Hay una tabla nueva lista para conmutar. */
+    volatile uint8_t  dirty;                          /**< Algún ancho cambió: reconstruir al cerrar el frame. */
+    uint16_t          frame_base;                     /**< TCNT1 del flanco de subida del frame actual. */
+    uint8_t           next;                           /**< 0: subida pendiente, n: ranura n-1 pendiente. */
+    uint8_t           used;                           /**< Servos registrados en el grupo. */
+    volatile uint8_t* port[SERVO_MUX_GROUP_SIZE];     /**< Configuración de cada canal. */
+    uint8_t           mask[SERVO_MUX_GROUP_SIZE];
+    uint16_t          ticks[SERVO_MUX_GROUP_SIZE];    /**< Ancho de pulso solicitado. */
+} servo_group_t;
+
+/** @} */
+
+/** @brief Grupos A (OCR1A) y B (OCR1B) del multiplexor. */
+static servo_group_t mux_group[2];
+
+/** @brief Cantidad total de canales registrados. */
+static uint8_t mux_used = 0;
+
+/** @brief Registro de servos gestionados por el perfilador de movimiento. */
+static Servo_t *motion_list[SERVO_MOTION_MAX];
+
+/** @brief Cantidad de servos registrados en el perfilador. */
+static uint8_t motion_used = 0;
+
+/* --- Funciones Privadas del Multiplexor --- */
+
+/**
+ * @brief Recalcula la tabla ordenada de un grupo en el buffer inactivo.
+ * @details Ordena los anchos de pulso por inserción (como máximo 5 elementos) y agrupa
+ * los flancos de subida por puerto. Solo la invoca la ISR del propio grupo, al cerrar
+ * el frame (después del último flanco de bajada): es el único escritor de la tabla
+ * inactiva, así que nunca hay dos reconstrucciones superpuestas ni una tabla a medio
+ * armar en el momento de conmutar, y el ordenamiento no agrega jitter a ningún flanco.
+ * @note La nueva tabla se aplica en el próximo flanco de subida (frame completo).
+ */
+static void Servo_Mux_Rebuild(servo_group_t *g) {
+    g->dirty = 0;
+    servo_table_t *t = &g->table[g->active ^ 1];
+
+    t->count = 0;
+    t->rise_count = 0;
+
+    for (uint8_t i = 0; i < g->used; i++) {
+        /* 1. Inserción ordenada por ancho de pulso */
+        uint8_t j = t->count;
+        while (j > 0 && t->slot[j - 1].offset > g->ticks[i]) {
+            t->slot[j] = t->slot[j - 1];
+            j--;
+        }
+        t->slot[j].offset = g->ticks[i];
+        t->slot[j].port   = g->port[i];
+        t->slot[j].mask   = g->mask[i];
+        t->count++;
+
+        /* 2. Agrupación de flancos de subida: una sola escritura por puerto */
+        uint8_t k = 0;
+        while (k < t->rise_count && t->rise[k].port != g->port[i]) k++;
+        if (k == t->rise_count) {
+            t->rise[k].port = g->port[i];
+            t->rise[k].mask = 0;
+            t->rise_count++;
+        }
+        t->rise[k].mask |= g->mask[i];
+    }
+
+    g->pending = 1;
+}
+
+/**
+ * @brief Espera activa hasta que TCNT1 alcance el tick indicado.
+ * @details La comparación con signo de 16 bits tolera el desborde natural del contador.
+ */
+static inline void Servo_Mux_WaitUntil(uint16_t target) {
+    while ((int16_t)(Timer1_Read_Counter() - target) < 0) {
+        /* Alineación fina al tick exacto */
+    }
+}
+
+/**
+ * @brief Atiende los eventos vencidos de un grupo y calcula la próxima alarma.
+ * @details 
+ * 1. Flanco de subida: conmuta el buffer si hay una tabla nueva y sube todos los pines.
+ * 2. Flancos de bajada: baja cada pin en su tick exacto. Si la siguiente ranura está a
+ * menos de 2 * SERVO_MUX_LEAD_TICKS, se atiende en la misma ISR para no perderla.
+ * 3. Al terminar el frame, avanza la base por acumulador (base += SERVO_MUX_FRAME_TICKS).
+ * @return Valor para el registro de comparación (siempre SERVO_MUX_LEAD_TICKS antes del evento).
+ */
+static uint16_t Servo_Mux_Service(servo_group_t *g) {
+    if (g->next == 0) {
+        if (g->pending) {
+            g->active ^= 1;
+            g->pending = 0;
+        }
+        servo_table_t *t = &g->table[g->active];
+        Servo_Mux_WaitUntil(g->frame_base);
+        for (uint8_t k = 0; k < t->rise_count; k++) {
+            *(t->rise[k].port) |= t->rise[k].mask;
+        }
+        g->next = 1;
+    }
+
+    servo_table_t *t = &g->table[g->active];
+    while (g->next <= t->count) {
+        servo_slot_t *s = &t->slot[g->next - 1];
+        uint16_t target = g->frame_base + s->offset;
+
+        if ((int16_t)(target - Timer1_Read_Counter()) >= (int16_t)(2 * SERVO_MUX_LEAD_TICKS)) {
+            return target - SERVO_MUX_LEAD_TICKS;
+        }
+        Servo_Mux_WaitUntil(target);
+        *(s->port) &= ~(s->mask);
+        g->next++;
+    }
+
+    /* Frame completo: se programa la subida del próximo frame */
+    g->next = 0;
+    g->frame_base += SERVO_MUX_FRAME_TICKS;
+
+    /**
+     * Tiempo libre hasta el próximo evento del grupo (más de 17ms) y del otro grupo
+     * (desfasado medio frame). El grupo A marca además el tick del perfilador: un frame
+     * de 20ms exacto, ya que el Overflow del Modo Normal ocurre cada 32.768ms.
+     */
+    if (g == &mux_group[0]) Servo_Motion_Update();
+    if (g->dirty) Servo_Mux_Rebuild(g);
+
+    return g->frame_base - SERVO_MUX_LEAD_TICKS;
+}
+
+/**
+ * @brief Actualiza el ancho de pulso de un canal multiplexado.
+ * @details Solo guarda el valor y marca el grupo: la tabla la reconstruye la ISR al
+ * cerrar el frame. La escritura de 16 bits se protege porque la ISR la lee.
+ * @param channel Canal asignado por @ref Servo_Init_Mux.
+ * @param ticks Ancho de pulso en ticks del Timer 1.
+ */
+static void Servo_Mux_Write(uint8_t channel, uint16_t ticks) {
+    servo_group_t *g = &mux_group[channel & 1];
+
+    uint8_t sreg = SREG;
+    cli();
+    g->ticks[channel >> 1] = ticks;
+    g->dirty = 1;
+    SREG = sreg;
+}
+
+/**
+ * @brief Precalcula los límites y el factor de escala de una instancia.
+ * @details El factor se guarda como recíproco en punto fijo Q16:
+ * scale = (max - min) * 65536 / 1800 (ticks por décima de grado).
+ * La única división de 32 bits del driver ocurre aquí, una vez por servo.
+ * @note Se redondea al entero más cercano; el error acumulado en 1800 décimas
+ * es menor a 0.03 ticks.
+ */
+static void Servo_Calibrate(Servo_t *instance, uint16_t min, uint16_t max) {
+    instance->min_ticks = min;
+    instance->max_ticks = max;
+    instance->scale_q16 = (((uint32_t)(max - min) << 16) + (SERVO_DECIDEG_MAX / 2)) / SERVO_DECIDEG_MAX;
+}
 
 /**
  * @brief Inicializa una instancia de servo con sus parámetros de calibración.
  * * @param instance Puntero a la estructura de datos del servo (Servo_t).
  * @param min Ticks de Timer correspondientes al ancho de pulso para 0° (típicamente 1ms).
  * @param max Ticks de Timer correspondientes al ancho de pulso para 180° (típicamente 2ms).
- * @param callback Puntero a la función de la Capa 1 que escribe en el registro OCR.
+ * @param ocr Canal PWM de 16 bits (dirección del registro OCR1x).
  * * @note Esta función no configura los registros del Timer. La inicialización del
  * periférico debe realizarse previamente en el Hardware Mapping.
  */
-void Servo_Init(Servo_t *instance, uint16_t min, uint16_t max, servo_write_hw_ptr callback) {
+void Servo_Init(Servo_t *instance, uint16_t min, uint16_t max, pwm16_channel_t ocr) {
     /* Verificación de punteros nulos para evitar fallos de segmentación */
-    if (instance == 0 || callback == 0) return;
+    if (instance == 0 || ocr == 0) return;
 
-    /* Configuración de los límites de la instancia */
-    instance->min_ticks = min;
-    instance->max_ticks = max;
-    instance->write_hw = callback;
+    /* Configuración de los límites y del factor de escala de la instancia */
+    Servo_Calibrate(instance, min, max);
+    instance->ocr = ocr;
+    instance->mux_channel = SERVO_MUX_NONE;
     Servo_SetAngle(instance, 0);
 }
 
 /**
- * @brief Establece el ángulo del servo calculando el duty cycle correspondiente.
+ * @brief Establece el ángulo del servo en grados enteros.
  * * @param instance Puntero a la instancia del servo que se desea mover.
  * @param angle Valor angular en grados (0 a 180).
- * * @details 
- * El mapeo se basa en la ecuación de la recta: y = y0 + (x - x0) * (y1 - y0) / (x1 - x0)
- * Donde:
- * - x es el ángulo deseado.
- * - y son los ticks resultantes para el OCR.
- * * @warning La función utiliza promoción a 32 bits para el cálculo intermedio. 
- * Esto es vital si se usan Timers de 16 bits (como el Timer 1) donde (angle * range)
- * puede superar fácilmente el límite de 65535 de un uint16_t.
+ * * @details Conserva la API original: convierte a décimas de grado (multiplicación
+ * 8x8 por hardware) y delega en @ref Servo_SetAngle_Deci.
  */
 void Servo_SetAngle(Servo_t *instance, uint8_t angle) {
-    /* Verificación de integridad de la instancia y el callback de hardware */
-    if (instance == 0 || instance->write_hw == 0) return;
-
     /* Saturación de límites: el SG90 físico no puede superar los 180 grados */
     if (angle > 180) {
         angle = 180;
     }
+    Servo_SetAngle_Deci(instance, (uint16_t)angle * 10);
+}
 
-    /**
-     * @brief Cálculo de ticks mediante aritmética de punto fijo.
-     * * 1. Calculamos el rango dinámico (delta de ticks).
-     * 2. Promocionamos 'angle' a uint32_t para asegurar que la multiplicación
-     * no desborde antes de la división por 180.
-     * 3. Sumamos el offset mínimo para posicionar en el cuadrante correcto.
-     */
-    uint32_t range = (uint32_t)(instance->max_ticks - instance->min_ticks);
-    uint32_t intermediate_calc = ((uint32_t)angle * range) / 180;
-    uint16_t target_ticks = (uint16_t)(intermediate_calc + instance->min_ticks);
+/**
+ * @brief Convierte décimas de grado a ticks y los escribe en la salida del servo.
+ * @details 
+ * El mapeo de la recta y = min + x * (max - min) / 1800 se resuelve con el
+ * recíproco precalculado en @ref Servo_Calibrate:
+ * ticks = min + ((x * scale_q16 + 0x8000) >> 16)
+ * * Una multiplicación 16x32 (__muluhisi3) y un desplazamiento de 16 bits, que en AVR
+ * se reduce a descartar los dos bytes bajos. Se elimina la división de 32 bits
+ * (__udivmodsi4) que se ejecutaba en cada llamada.
+ * @note Es invocada tanto desde el contexto principal como desde @ref Servo_Motion_Update.
+ */
+static void Servo_Output(Servo_t *instance, uint16_t decideg) {
+    /* Multiplicación-desplazamiento en punto fijo Q16 (con redondeo) */
+    uint16_t offset = (uint16_t)(((uint32_t)decideg * instance->scale_q16 + 0x8000UL) >> 16);
+    uint16_t target_ticks = instance->min_ticks + offset;
 
     /**
      * @brief Inyección de hardware.
-     * Se invoca la función callback pasando el valor de ticks calculado.
-     * Esto permite que esta misma lógica mueva un servo en OCR1A, OCR1B o incluso Soft-PWM.
+     * Escritura directa sobre el registro OCR inyectado (sin llamada indirecta), o
+     * sobre la tabla del multiplexor si el servo está en un GPIO arbitrario.
      */
-    instance->write_hw(target_ticks);
+    if (instance->mux_channel != SERVO_MUX_NONE) {
+        Servo_Mux_Write(instance->mux_channel, target_ticks);
+    } else {
+        PWM16_Write(instance->ocr, target_ticks);
+    }
+}
+
+/**
+ * @brief Establece el ángulo del servo con resolución de 0.1°.
+ * * @param instance Puntero a la instancia del servo que se desea mover.
+ * @param decideg Ángulo en décimas de grado (0 a 1800).
+ * * @details El posicionamiento es inmediato: cancela cualquier perfil de movimiento
+ * en curso y sincroniza la posición del perfilador con el nuevo ángulo.
+ */
+void Servo_SetAngle_Deci(Servo_t *instance, uint16_t decideg) {
+    /* Verificación de integridad de la instancia y de su salida (OCR o multiplexor) */
+    if (instance == 0) return;
+    if (instance->ocr == 0 && instance->mux_channel == SERVO_MUX_NONE) return;
+
+    /* Saturación de límites: 180.0 grados */
+    if (decideg > SERVO_DECIDEG_MAX) {
+        decideg = SERVO_DECIDEG_MAX;
+    }
+
+    /* Sección crítica: el perfil podría estar siendo leído por la ISR */
+    uint8_t sreg = SREG;
+    cli();
+    instance->mp_moving = 0;
+    instance->mp_vel    = 0;
+    instance->mp_pos    = (int16_t)(decideg << 4);
+    instance->mp_target = instance->mp_pos;
+    SREG = sreg;
+
+    /* Fuera de la sección crítica: con mp_moving = 0 la ISR ya no toca esta instancia */
+    Servo_Output(instance, decideg);
+}
+
+/* --- Implementación del Perfilador de Movimiento --- */
+
+/**
+ * @brief Avanza un frame la trayectoria de un servo.
+ * @details Se trabaja con la velocidad proyectada sobre la dirección del objetivo
+ * ('speed' > 0 acerca, < 0 aleja). Regla de frenado del trapecio: la distancia de
+ * detención a aceleración 'a' es v²/2a, por lo que se frena cuando v² > 2·a·d.
+ * Todas las operaciones son enteras; los productos se evalúan en 32 bits.
+ */
+static void Servo_Motion_Step(Servo_t *s) {
+    int16_t  dist  = s->mp_target - s->mp_pos;
+    uint16_t adist = (dist < 0) ? (uint16_t)(-dist) : (uint16_t)dist;
+    int16_t  speed = (dist < 0) ? -s->mp_vel : s->mp_vel;
+    int16_t  accel = (int16_t)s->mp_accel;
+    int16_t  vmax  = (int16_t)s->mp_vmax;
+
+    if (accel == 0) {
+        /* Perfil de velocidad constante */
+        speed = vmax;
+    } else if (speed < 0) {
+        /* Se mueve en sentido contrario (objetivo cambiado): frenar primero */
+        speed += accel;
+    } else if ((uint32_t)speed * (uint32_t)speed > 2UL * (uint32_t)accel * adist) {
+        /* Rampa de desaceleración; se conserva un avance mínimo para no estancarse */
+        speed -= accel;
+        if (speed < accel) speed = accel;
+    } else if (speed < vmax) {
+        /* Rampa de aceleración */
+        speed += accel;
+        if (speed > vmax) speed = vmax;
+    }
+
+    /* Llegada: el próximo avance alcanza o supera el objetivo */
+    if (speed >= 0 && (uint16_t)speed >= adist) {
+        s->mp_pos    = s->mp_target;
+        s->mp_vel    = 0;
+        s->mp_moving = 0;
+    } else {
+        s->mp_vel  = (dist < 0) ? -speed : speed;
+        s->mp_pos += s->mp_vel;
+    }
+
+    /* Redondeo de Q4 a décimas de grado */
+    Servo_Output(s, (uint16_t)(s->mp_pos + 8) >> 4);
+}
+
+/**
+ * @brief Inicia un movimiento trapezoidal hacia un ángulo objetivo.
+ * @details La primera llamada para una instancia la agrega al registro del perfilador.
+ * Los parámetros se cargan en sección crítica, de modo que la ISR nunca observa un
+ * objetivo a medio escribir. La velocidad actual se conserva, por lo que un cambio de
+ * objetivo en pleno movimiento produce una transición continua.
+ */
+bool Servo_MoveTo(Servo_t *instance, uint16_t decideg, uint16_t vmax, uint16_t accel) {
+    if (instance == 0) return false;
+    if (instance->ocr == 0 && instance->mux_channel == SERVO_MUX_NONE) return false;
+
+    /* Velocidad nula: posicionamiento inmediato */
+    if (vmax == 0) {
+        Servo_SetAngle_Deci(instance, decideg);
+        return true;
+    }
+
+    if (decideg > SERVO_DECIDEG_MAX) decideg = SERVO_DECIDEG_MAX;
+    if (vmax > 0x7FFF) vmax = 0x7FFF;
+    if (accel > 0x7FFF) accel = 0x7FFF;
+
+    uint8_t sreg = SREG;
+    cli();
+
+    /* Alta en el registro (búsqueda lineal, como máximo SERVO_MOTION_MAX entradas) */
+    uint8_t i;
+    for (i = 0; i < motion_used; i++) {
+        if (motion_list[i] == instance) break;
+    }
+    if (i == motion_used) {
+        if (motion_used >= SERVO_MOTION_MAX) {
+            SREG = sreg;
+            return false;
+        }
+        motion_list[motion_used++] = instance;
+    }
+
+    instance->mp_target = (int16_t)(decideg << 4);
+    instance->mp_vmax   = vmax;
+    instance->mp_accel  = accel;
+    instance->mp_moving = (instance->mp_target != instance->mp_pos);
+    SREG = sreg;
+    return true;
+}
+
+bool Servo_IsMoving(const Servo_t *instance) {
+    if (instance == 0) return false;
+    return instance->mp_moving != 0;
+}
+
+/**
+ * @brief Avanza un frame el perfil de todos los servos registrados.
+ * @details Pensada para ISR(TIMER1_OVF_vect) en Fast PWM: el OCR actualizado se
+ * aplica en el siguiente TOP gracias al doble buffer del Timer, así cada pulso
+ * corresponde exactamente a una muestra de la trayectoria. Con el multiplexor la
+ * invoca la ISR del grupo A al cerrar cada frame de 20ms.
+ */
+void Servo_Motion_Update(void) {
+    for (uint8_t i = 0; i < motion_used; i++) {
+        Servo_t *s = motion_list[i];
+        if (s->mp_moving) {
+            Servo_Motion_Step(s);
+        }
+    }
+}
+
+/* --- Implementación del Multiplexor de Servos --- */
+
+/**
+ * @brief Configura el Timer 1 y las alarmas de ambos grupos.
+ * @details El Timer 1 opera en Modo Normal con prescaler 8 (0.5us por tick). Como el
+ * contador recorre 0-65535 libremente, cada grupo avanza su base por acumulador, la misma
+ * técnica usada para el motor PaP en el Proyecto 08. El grupo B se desfasa medio frame
+ * para que nunca coincidan los flancos de ambos grupos.
+ */
+void Servo_Mux_Init(void) {
+    Timer1_Normal_Init(T1_CLK_8, T1_PIN_DISCONNECT, T1_PIN_DISCONNECT);
+    Timer1_Write_Counter(0);
+
+    mux_group[0].frame_base = 1000;
+    mux_group[1].frame_base = 1000 + (SERVO_MUX_FRAME_TICKS / 2);
+    mux_group[0].next = 0;
+    mux_group[1].next = 0;
+
+    Timer1_Set_AlarmA(mux_group[0].frame_base - SERVO_MUX_LEAD_TICKS);
+    Timer1_Set_AlarmB(mux_group[1].frame_base - SERVO_MUX_LEAD_TICKS);
+}
+
+/**
+ * @brief Registra un servo en el multiplexor y lo posiciona en 0°.
+ * @details Los canales se reparten alternadamente entre el grupo A y el grupo B para
+ * equilibrar la cantidad de flancos atendidos por cada ISR.
+ * * @note Implementa aritmética de punteros: la dirección del DDRx es (PORTx - 1).
+ */
+bool Servo_Init_Mux(Servo_t *instance, uint16_t min, uint16_t max, volatile uint8_t *port, uint8_t pin) {
+    if (instance == 0 || port == 0 || mux_used >= SERVO_MUX_MAX_CHANNELS) return false;
+
+    uint8_t channel = mux_used;
+    servo_group_t *g = &mux_group[channel & 1];
+    uint8_t idx = channel >> 1;
+
+    /* Configuración del pin como salida en estado bajo */
+    *port &= ~(1 << pin);
+    *(port - 1) |= (1 << pin);
+
+    g->port[idx]  = port;
+    g->mask[idx]  = (1 << pin);
+    g->ticks[idx] = min;
+    g->used++;
+    mux_used++;
+
+    Servo_Calibrate(instance, min, max);
+    instance->ocr = 0;
+    instance->mux_channel = channel;
+    Servo_SetAngle(instance, 0);
+    return true;
+}
+
+/**
+ * @brief Atiende el grupo A desde ISR(TIMER1_COMPA_vect).
+ */
+void Servo_Mux_IRQHandler_A(void) {
+    Timer1_Reload_AlarmA(Servo_Mux_Service(&mux_group[0]));
+}
+
+/**
+ * @brief Atiende el grupo B desde ISR(TIMER1_COMPB_vect).
+ */
+void Servo_Mux_IRQHandler_B(void) {
+    Timer1_Reload_AlarmB(Servo_Mux_Service(&mux_group[1]));
 }
\ No newline at end of file
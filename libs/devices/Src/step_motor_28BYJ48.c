@@ -4,13 +4,16 @@
  * @author Mamani Flores Carlos
  * @date 2026
  * * @details Este driver implementa el control de fases para motores unipolares 
- * utilizando una arquitectura de mapeo de pines flexible. Optimiza el uso de 
- * memoria RAM almacenando las secuencias de excitación en la memoria FLASH (PROGMEM).
+ * utilizando una arquitectura de mapeo de pines flexible. Las secuencias de
+ * excitación residen en la memoria FLASH (PROGMEM); al inicializar se traducen a
+ * máscaras por puerto (32 bytes de RAM por motor) para que cada paso sea una única
+ * escritura por puerto.
  * La lógica es agnóstica al hardware, permitiendo distribuir las fases (IN1-IN4)
  * en cualquier puerto del MCU.
  */
 
 #include <avr/pgmspace.h>
+#include <avr/interrupt.h>
 #include "step_motor_28BYJ48.h"
 
 /** * @name Tablas de Secuencia en FLASH
@@ -31,18 +34,104 @@ const uint8_t FULL_STEP_TABLE[] PROGMEM = {
 const uint8_t HALF_STEP_TABLE[] PROGMEM = { 
     0x08, 0x0C, 0x04, 0x06, 0x02, 0x03, 0x01, 0x09 
 };
+
+/**
+ * @brief Cuarto de onda senoidal: sin(k * 90° / 32) * 255, k = 0..32.
+ * @details Un paso completo equivale a 90° eléctricos; con 32 intervalos la tabla
+ * cubre la resolución máxima de 1/32 de paso. Los demás cuadrantes se obtienen por
+ * simetría, por lo que bastan 33 bytes de FLASH.
+ */
+const uint8_t SINE_QUARTER_TABLE[33] PROGMEM = {
+      0,  13,  25,  37,  50,  62,  74,  86,
+     98, 109, 120, 131, 142, 152, 162, 171,
+    180, 189, 197, 205, 212, 219, 225, 231,
+    236, 240, 244, 247, 250, 252, 254, 255,
+    255
+};
 /** @} */
 
+/** @brief Micropasos de 1/32 por ciclo eléctrico completo (4 pasos completos). */
+#define MICRO_CYCLE             128
+/** @brief Micropasos de 1/32 por paso completo (90° eléctricos). */
+#define MICRO_QUARTER           32
+/** @brief Valor saturado de micro_ticks: no hubo pasos recientes (arranque desde reposo). */
+#define MICRO_TICKS_IDLE        0xFFFF
+
+/**
+ * @brief Agrupa las fases por puerto y precalcula el valor de cada puerto por paso.
+ * @param hstepper Puntero a la instancia del motor.
+ * @details Para cada paso de la secuencia (Full o Half) y cada puerto distinto, se
+ * guarda la combinación de bits a escribir. En la ISR el paso se reduce a una sola
+ * operación lectura-modificación-escritura por puerto, y todas las bobinas de un mismo
+ * puerto conmutan en la misma instrucción (sin estados intermedios inválidos).
+ */
+static void Stepper_Build_Masks(Stepper_t* hstepper) {
+    hstepper->port_count = 0;
+
+    /* 1. Agrupación de pines por puerto */
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t p;
+        for (p = 0; p < hstepper->port_count; p++) {
+            if (hstepper->port_reg[p] == hstepper->GPIO_Ports[i]) break;
+        }
+        if (p == hstepper->port_count) {
+            hstepper->port_reg[p]  = hstepper->GPIO_Ports[i];
+            hstepper->port_mask[p] = 0;
+            hstepper->port_count++;
+        }
+        hstepper->port_mask[p] |= (1 << hstepper->GPIO_Pins[i]);
+    }
+
+    /* 2. Traducción de cada patrón de la tabla (FLASH) a bits de puerto */
+    uint8_t steps = (hstepper->mode == MODE_HALF_STEP) ? 8 : 4;
+    for (uint8_t k = 0; k < steps; k++) {
+        uint8_t state_bits = (hstepper->mode == MODE_HALF_STEP)
+                           ? pgm_read_byte(&HALF_STEP_TABLE[k])
+                           : pgm_read_byte(&FULL_STEP_TABLE[k]);
+
+        for (uint8_t p = 0; p < hstepper->port_count; p++) {
+            hstepper->phase_bits[k][p] = 0;
+        }
+        for (uint8_t i = 0; i < 4; i++) {
+            if (!(state_bits & (1 << i))) continue;
+            for (uint8_t p = 0; p < hstepper->port_count; p++) {
+                if (hstepper->port_reg[p] == hstepper->GPIO_Ports[i]) {
+                    hstepper->phase_bits[k][p] |= (1 << hstepper->GPIO_Pins[i]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Deja el handle inerte ante una configuración inválida.
+ * @details Sin puertos ni canales asociados: Step/Stop/Hold no escriben ningún registro.
+ */
+static void Stepper_Reject(Stepper_t* hstepper) {
+    hstepper->mode       = MODE_FULL_STEP;
+    hstepper->port_count = 0;
+    hstepper->is_active  = false;
+    hstepper->energized  = false;
+    hstepper->positioning = false;
+    hstepper->hold_timeout = 0;
+}
+
 /**
  * @brief Inicializa la estructura del motor y configura los pines como salidas.
  * @param hstepper Puntero a la instancia del motor (Handle).
  * @param ports Array de punteros a los puertos PORTx de cada fase.
  * @param pins Array con los números de pin respectivos (0-7).
  * @param mode Modo de paso inicial (FULL o HALF step).
+ * * @note MODE_MICRO_STEP no tiene canales PWM asociados en esta ruta: se rechaza.
  * * @note Implementa aritmética de punteros: En AVR, la dirección del registro DDRx 
  * es siempre (PORTx - 1). Esto permite configurar el modo salida sin punteros extra.
  */
 void Stepper_Init(Stepper_t* hstepper, volatile uint8_t* ports[], uint8_t pins[], Step_Mode_t mode) {
+    if (mode != MODE_FULL_STEP && mode != MODE_HALF_STEP) {
+        Stepper_Reject(hstepper);
+        return;
+    }
+
     for(uint8_t i = 0; i < 4; i++) {
         hstepper->GPIO_Ports[i] = ports[i];
         hstepper->GPIO_Pins[i]  = pins[i];
@@ -56,45 +145,219 @@ void Stepper_Init(Stepper_t* hstepper, volatile uint8_t* ports[], uint8_t pins[]
     hstepper->mode = mode;
     hstepper->is_active = false;
     hstepper->direction = STEP_CW;
+    hstepper->hold_timeout = 0;
+    hstepper->holding = false;
+    hstepper->position = 0;
+    hstepper->target = 0;
+    hstepper->positioning = false;
+    hstepper->move_done = true;
+    hstepper->on_done = 0;
+
+    Stepper_Build_Masks(hstepper);
     
     Stepper_Stop(hstepper); // Estado seguro inicial (bobinas desenergizadas)
 }
 
+/**
+ * @brief Inicializa un motor en modo micropaso con las bobinas manejadas por PWM.
+ * @details No se usan los registros PORTx: los pines quedan bajo control de los
+ * canales PWM, que la aplicación configura en su Hardware Mapping. Cada bobina se
+ * escribe con un ST indirecto al OCR (sin llamada a función por canal).
+ */
+void Stepper_Init_Micro(Stepper_t* hstepper, const pwm8_channel_t pwm[], Step_Micro_t resolution) {
+    /* Un canal NULL haría que PWM8_Write escribiera en la dirección 0 (registro R0) */
+    for (uint8_t i = 0; i < 4; i++) {
+        if (!pwm || !pwm[i]) {
+            Stepper_Reject(hstepper);
+            return;
+        }
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        hstepper->pwm[i] = pwm[i];
+    }
+    if (resolution < MICRO_1_8)  resolution = MICRO_1_8;
+    if (resolution > MICRO_1_32) resolution = MICRO_1_32;
+
+    hstepper->micro_stride   = (uint8_t)(MICRO_QUARTER >> resolution);
+    hstepper->micro_per_step = (uint8_t)(1 << resolution);
+    hstepper->micro_phase    = 0;
+    hstepper->micro_ticks    = MICRO_TICKS_IDLE;
+    hstepper->micro_period   = MICRO_TICKS_IDLE;
+    hstepper->micro_acc      = 0;
+    hstepper->port_count   = 0;
+    hstepper->current_step = 0;
+    hstepper->mode         = MODE_MICRO_STEP;
+    hstepper->is_active    = false;
+    hstepper->direction    = STEP_CW;
+    hstepper->hold_timeout = 0;
+    hstepper->holding      = false;
+    hstepper->position     = 0;
+    hstepper->target       = 0;
+    hstepper->positioning  = false;
+    hstepper->move_done    = true;
+    hstepper->on_done      = 0;
+
+    Stepper_Stop(hstepper); // Estado seguro inicial (bobinas desenergizadas)
+}
+
+/**
+ * @brief Aplica la corriente de las 4 bobinas para la fase eléctrica interpolada.
+ * @details La bobina i está centrada en (3 - i) * 90°, igual que FULL_STEP_TABLE
+ * (IN4 primero en sentido horario). Su ciclo de trabajo es la parte positiva de
+ * cos(θ - centro): solo las dos bobinas adyacentes a θ conducen, con corrientes
+ * seno/coseno, y el vector de campo mantiene módulo constante.
+ * @param scale Fracción de corriente (255 = nominal, menor en modo Hold).
+ */
+static void Stepper_Micro_Apply(Stepper_t* hstepper, uint8_t scale) {
+    uint8_t theta = hstepper->micro_phase;
+
+    for (uint8_t i = 0; i < 4; i++) {
+        uint8_t d = (theta - (uint8_t)((3 - i) * MICRO_QUARTER)) & (MICRO_CYCLE - 1);
+        uint8_t duty = 0;
+
+        if (d <= MICRO_QUARTER) {
+            duty = pgm_read_byte(&SINE_QUARTER_TABLE[MICRO_QUARTER - d]);
+        } else if (d >= MICRO_CYCLE - MICRO_QUARTER) {
+            duty = pgm_read_byte(&SINE_QUARTER_TABLE[d - (MICRO_CYCLE - MICRO_QUARTER)]);
+        }
+        /* Escala de corriente (255 = nominal): multiplicación 8x8 por hardware */
+        if (scale != 255) {
+            duty = (uint8_t)(((uint16_t)duty * scale) >> 8);
+        }
+        PWM8_Write(hstepper->pwm[i], duty);
+    }
+}
+
+/**
+ * @brief Paso completo en modo micropaso: fija la nueva fase objetivo (±90°).
+ * @details Solo toca los OCR si el interpolador quedó atrás (el paso anterior duró menos
+ * que el medido), al arrancar desde reposo o al salir del modo Hold; así el retraso nunca
+ * supera un paso y el costo en la ISR de pasos no depende de la resolución.
+ * @param restore true si los OCR tenían la corriente reducida del modo Hold.
+ */
+static void Stepper_Micro_Step(Stepper_t* hstepper, bool restore) {
+    uint8_t target = (uint8_t)hstepper->current_step;
+    bool apply = restore || (hstepper->micro_phase != target);
+
+    /* Lo pendiente del paso anterior se completa de inmediato */
+    hstepper->micro_phase = target;
+
+    target = (hstepper->direction == STEP_CW) ? (target + MICRO_QUARTER)
+                                              : (target - MICRO_QUARTER);
+    target &= (MICRO_CYCLE - 1);
+    hstepper->current_step = (int8_t)target;
+
+    /* El paso que termina define la duración estimada del siguiente */
+    hstepper->micro_period = hstepper->micro_ticks;
+    hstepper->micro_ticks  = 0;
+    hstepper->micro_acc    = 0;
+
+    /* Desde reposo no hay periodo medido: primer paso completo directo */
+    if (hstepper->micro_period == MICRO_TICKS_IDLE) {
+        hstepper->micro_phase = target;
+        apply = true;
+    }
+    if (apply) Stepper_Micro_Apply(hstepper, 255);
+}
+
+/**
+ * @brief Interpolador de micropasos (ISR de Overflow del Timer PWM).
+ * @details DDA: por overflow el acumulador suma los micropasos de un paso y cada vez que
+ * supera el periodo medido (en overflows) la fase avanza un micropaso. En régimen los
+ * 'micro_per_step' micropasos quedan repartidos uniformemente en el paso, sin divisiones.
+ * El sentido sale de la diferencia con signo entre objetivo y fase (ciclo de 128), por lo
+ * que un cambio de dirección entre pasos no desorienta al interpolador.
+ */
+void Stepper_Micro_IRQHandler(Stepper_t* hstepper) {
+    if (hstepper->mode != MODE_MICRO_STEP || !hstepper->energized) return;
+
+    if (hstepper->micro_ticks != MICRO_TICKS_IDLE) hstepper->micro_ticks++;
+
+    uint8_t phase = hstepper->micro_phase;
+    int8_t diff = (int8_t)((uint8_t)(((uint8_t)hstepper->current_step - phase) << 1)) >> 1;
+    if (diff == 0) return;
+
+    /* Micropasos que corresponden a este overflow (a lo sumo un paso completo) */
+    uint16_t period = hstepper->micro_period;
+    uint16_t acc = hstepper->micro_acc + hstepper->micro_per_step;
+    uint8_t moves = 0;
+    while (acc >= period && moves < hstepper->micro_per_step) {
+        acc -= period;
+        moves++;
+    }
+    hstepper->micro_acc = (period == 0) ? 0 : acc;
+    if (moves == 0) return;
+
+    /* Avance hacia el objetivo sin pasarse */
+    uint8_t delta = moves * hstepper->micro_stride;
+    if (diff > 0) {
+        phase = (delta >= (uint8_t)diff) ? (uint8_t)hstepper->current_step : (phase + delta);
+    } else {
+        phase = (delta >= (uint8_t)(-diff)) ? (uint8_t)hstepper->current_step : (phase - delta);
+    }
+    hstepper->micro_phase = phase & (MICRO_CYCLE - 1);
+
+    Stepper_Micro_Apply(hstepper, hstepper->holding ? hstepper->hold_duty : 255);
+}
+
+static void Stepper_Step_Phases(Stepper_t* hstepper);
+
 /**
  * @brief Ejecuta el siguiente paso de la secuencia de excitación.
  * @param hstepper Puntero a la instancia del motor.
- * * @details Calcula el índice circular según la dirección de giro y el modo. 
- * Recupera el patrón de bits desde FLASH y lo mapea a los puertos físicos.
+ * * @details El índice circular se obtiene con una máscara (longitud de secuencia
+ * potencia de 2) en lugar de un módulo. El patrón ya viene traducido a bits de puerto
+ * por @ref Stepper_Build_Masks, por lo que se escribe a lo sumo una vez por puerto.
+ * Además mantiene la posición absoluta y, con un objetivo cargado por
+ * @ref Stepper_MoveTo, se detiene exactamente en él.
  * Esta función debe ser llamada periódicamente (ej. desde un Timer) para 
  * controlar la velocidad de rotación.
  */
 void Stepper_Step_Sequential(Stepper_t* hstepper) {
     if (!hstepper->is_active) return;
 
-    uint8_t state_bits;
-    uint8_t max_idx = (hstepper->mode == MODE_HALF_STEP) ? 8 : 4;
+    /* Todo paso restablece la corriente nominal (sale del modo Hold) */
+    bool was_holding     = hstepper->holding;
+    hstepper->idle_ticks = 0;
+    hstepper->holding    = false;
+    hstepper->energized  = true;
 
-    /* 1. Cálculo del índice circular con protección de desbordamiento */
-    if (hstepper->direction == STEP_CW) {
-        hstepper->current_step = (hstepper->current_step + 1) % max_idx;
+    /* Micropaso: la ISR de pasos solo avanza 90°; el Overflow del PWM interpola */
+    if (hstepper->mode == MODE_MICRO_STEP) {
+        Stepper_Micro_Step(hstepper, was_holding);
     } else {
-        hstepper->current_step = (hstepper->current_step - 1 + max_idx) % max_idx;
+        Stepper_Step_Phases(hstepper);
     }
 
-    /* 2. Recuperación de datos desde Memoria FLASH (PROGMEM) */
-    if (hstepper->mode == MODE_HALF_STEP) {
-        state_bits = pgm_read_byte(&HALF_STEP_TABLE[hstepper->current_step]);
-    } else {
-        state_bits = pgm_read_byte(&FULL_STEP_TABLE[hstepper->current_step]);
+    /* Contador absoluto y detección de llegada (dentro de la misma ISR) */
+    hstepper->position += (hstepper->direction == STEP_CW) ? 1 : -1;
+    if (hstepper->positioning && hstepper->position == hstepper->target) {
+        /* Fin del movimiento: no se avanza más allá del objetivo y no queda estado
+         * que bloquee un giro continuo posterior (las bobinas siguen energizadas) */
+        hstepper->positioning = false;
+        hstepper->is_active   = false;
+        hstepper->move_done   = true;
+        if (hstepper->on_done) hstepper->on_done(hstepper);
     }
+}
 
-    /* 3. Mapeo de bits de la tabla a los pines físicos configurados */
-    for (uint8_t i = 0; i < 4; i++) {
-        if (state_bits & (1 << i)) {
-            *(hstepper->GPIO_Ports[i]) |= (1 << hstepper->GPIO_Pins[i]);
-        } else {
-            *(hstepper->GPIO_Ports[i]) &= ~(1 << hstepper->GPIO_Pins[i]);
-        }
+/**
+ * @brief Avanza la secuencia Full/Half y escribe las fases (una vez por puerto).
+ */
+static void Stepper_Step_Phases(Stepper_t* hstepper) {
+    uint8_t idx_mask = (hstepper->mode == MODE_HALF_STEP) ? 7 : 3;
+
+    /* 1. Índice circular: el desborde de -1 se corrige con la máscara */
+    uint8_t step = (uint8_t)hstepper->current_step;
+    step = (hstepper->direction == STEP_CW) ? (step + 1) : (step - 1);
+    step &= idx_mask;
+    hstepper->current_step = (int8_t)step;
+
+    /* 2. Una escritura por puerto: todas las fases del puerto cambian a la vez */
+    const uint8_t* bits = hstepper->phase_bits[step];
+    for (uint8_t p = 0; p < hstepper->port_count; p++) {
+        volatile uint8_t* port = hstepper->port_reg[p];
+        *port = (*port & ~hstepper->port_mask[p]) | bits[p];
     }
 }
 
@@ -107,6 +370,128 @@ void Stepper_Set_Direction(Stepper_t* hstepper, Step_Dir_t dir) {
     hstepper->direction = dir;
 }
 
+/**
+ * @brief Carga un objetivo absoluto y devuelve la distancia en pasos.
+ * @details La posición se lee y el objetivo se escribe en sección crítica: ambos son de
+ * 32 bits y la ISR de pasos los modifica/compara.
+ */
+uint32_t Stepper_MoveTo(Stepper_t* hstepper, int32_t target) {
+    uint8_t sreg = SREG;
+    cli();
+    int32_t delta = target - hstepper->position;
+    hstepper->target      = target;
+    hstepper->positioning = (delta != 0);
+    hstepper->move_done   = (delta == 0);
+    if (delta != 0) {
+        hstepper->direction = (delta > 0) ? STEP_CW : STEP_CCW;
+        hstepper->is_active = true;
+    }
+    SREG = sreg;
+
+    return (delta < 0) ? (uint32_t)(-delta) : (uint32_t)delta;
+}
+
+void Stepper_Cancel_Move(Stepper_t* hstepper) {
+    uint8_t sreg = SREG;
+    cli();
+    hstepper->positioning = false;
+    hstepper->move_done   = true;
+    SREG = sreg;
+}
+
+uint32_t Stepper_MoveRelative(Stepper_t* hstepper, int32_t delta) {
+    return Stepper_MoveTo(hstepper, Stepper_Get_Position(hstepper) + delta);
+}
+
+void Stepper_Set_Position(Stepper_t* hstepper, int32_t position) {
+    uint8_t sreg = SREG;
+    cli();
+    hstepper->position    = position;
+    hstepper->target      = position;
+    hstepper->positioning = false;
+    hstepper->move_done   = true;
+    SREG = sreg;
+}
+
+int32_t Stepper_Get_Position(const Stepper_t* hstepper) {
+    uint8_t sreg = SREG;
+    cli();
+    int32_t pos = hstepper->position;
+    SREG = sreg;
+    return pos;
+}
+
+bool Stepper_Is_Done(const Stepper_t* hstepper) {
+    return hstepper->move_done;
+}
+
+void Stepper_Set_Done_Callback(Stepper_t* hstepper, stepper_done_cb_t cb) {
+    hstepper->on_done = cb;
+}
+
+/**
+ * @brief Configura la reducción de corriente en reposo (modo Hold).
+ * @param hstepper Puntero a la instancia.
+ * @param timeout Ticks de servicio sin pasos antes de reducir (0 = desactivado).
+ * @param duty Corriente de retención sobre 256.
+ */
+void Stepper_Hold_Config(Stepper_t* hstepper, uint16_t timeout, uint8_t duty) {
+    hstepper->hold_duty    = duty;
+    hstepper->hold_timeout = timeout;
+    hstepper->idle_ticks   = 0;
+    hstepper->holding      = false;
+}
+
+/**
+ * @brief Escribe en cada puerto las fases del paso actual o las apaga.
+ */
+static void Stepper_Write_Phases(Stepper_t* hstepper, bool on) {
+    const uint8_t* bits = hstepper->phase_bits[(uint8_t)hstepper->current_step];
+    for (uint8_t p = 0; p < hstepper->port_count; p++) {
+        volatile uint8_t* port = hstepper->port_reg[p];
+        *port = (*port & ~hstepper->port_mask[p]) | (on ? bits[p] : 0);
+    }
+}
+
+/**
+ * @brief Servicio del modo Hold (tasa fija).
+ * @details El chopper es un modulador sigma-delta de 8 bits: en cada tick se suma
+ * 'hold_duty' al acumulador y el acarreo decide si las fases conducen. Así el tiempo
+ * encendido promedio es exactamente duty/256 sin divisiones, y los pulsos quedan
+ * distribuidos de forma uniforme (máxima frecuencia de troceado para cada duty).
+ * * Potencia en la bobina: si el troceado es más rápido que la constante L/R la corriente
+ * media escala con el duty y la disipación con duty²; si es más lento, con el duty.
+ * Con duty = 64 (25%) la disipación en reposo cae entre 4 y 16 veces.
+ */
+void Stepper_Hold_Service(Stepper_t* hstepper) {
+    if (!hstepper->energized || hstepper->hold_timeout == 0) return;
+
+    if (!hstepper->holding) {
+        if (++hstepper->idle_ticks < hstepper->hold_timeout) return;
+
+        /* Entrada al modo Hold */
+        hstepper->holding  = true;
+        hstepper->chop_acc = 0;
+        hstepper->chop_on  = true;
+        if (hstepper->mode == MODE_MICRO_STEP) {
+            Stepper_Micro_Apply(hstepper, hstepper->hold_duty);
+            return;
+        }
+    }
+
+    /* En micropaso el PWM por hardware ya mantiene la corriente reducida */
+    if (hstepper->mode == MODE_MICRO_STEP) return;
+
+    uint8_t acc = hstepper->chop_acc + hstepper->hold_duty;
+    bool on = (acc < hstepper->chop_acc);   /* Acarreo del acumulador */
+    hstepper->chop_acc = acc;
+
+    if (on != hstepper->chop_on) {
+        hstepper->chop_on = on;
+        Stepper_Write_Phases(hstepper, on);
+    }
+}
+
 /**
  * @brief Detiene el motor y desenergiza las bobinas.
  * @param hstepper Puntero a la instancia.
@@ -114,8 +499,202 @@ void Stepper_Set_Direction(Stepper_t* hstepper, Step_Dir_t dir) {
  * del integrado driver (ej. ULN2003) y del propio motor durante periodos de inactividad.
  */
 void Stepper_Stop(Stepper_t* hstepper) {
-    hstepper->is_active = false;
-    for (uint8_t i = 0; i < 4; i++) {
-        *(hstepper->GPIO_Ports[i]) &= ~(1 << hstepper->GPIO_Pins[i]);
+    hstepper->is_active   = false;
+    hstepper->energized   = false;
+    hstepper->holding     = false;
+    hstepper->positioning = false;
+    hstepper->move_done   = true;
+    if (hstepper->mode == MODE_MICRO_STEP) {
+        for (uint8_t i = 0; i < 4; i++) {
+            PWM8_Write(hstepper->pwm[i], 0);
+        }
+        /* El próximo arranque parte de la fase objetivo, sin periodo medido */
+        hstepper->micro_phase = (uint8_t)hstepper->current_step;
+        hstepper->micro_ticks = MICRO_TICKS_IDLE;
+        return;
+    }
+    for (uint8_t p = 0; p < hstepper->port_count; p++) {
+        *(hstepper->port_reg[p]) &= ~hstepper->port_mask[p];
+    }
+}
+
+/* --- Generador de Rampas --- */
+
+/**
+ * @brief Producto (a * b) >> 16 con a de 32 bits y b de 16 bits.
+ * @details Se descompone a = ah * 2^16 + al para usar dos multiplicaciones 16x16->32
+ * (instrucción MUL por hardware) en lugar de una multiplicación de 64 bits.
+ */
+static inline uint32_t Ramp_Mul_Shr16(uint32_t a, uint16_t b) {
+    uint16_t ah = (uint16_t)(a >> 16);
+    uint16_t al = (uint16_t)a;
+    return (uint32_t)ah * b + (((uint32_t)al * b) >> 16);
+}
+
+/**
+ * @brief Recalcula el intervalo c = 2^32 / V sin dividir.
+ * @details Una iteración de Newton-Raphson partiendo del intervalo anterior:
+ * e = V·c / 2^32 - 1  ->  c' = c·(1 - e).
+ * Como V cambia poco entre pasos consecutivos, el error tras una iteración es del
+ * orden de e² y además se corrige en el paso siguiente (no se acumula).
+ */
+static uint16_t Ramp_Reciprocal(uint32_t v, uint16_t c) {
+    int32_t e = (int32_t)Ramp_Mul_Shr16(v, c) - 65536L;
+
+    /* Acota la corrección a ±25% por paso para garantizar la convergencia */
+    if (e > 16384)  e = 16384;
+    if (e < -16384) e = -16384;
+
+    return (uint16_t)((int32_t)c - (((int32_t)c * e) >> 16));
+}
+
+/**
+ * @brief Precalcula los parámetros del perfil de velocidad.
+ * @details Las únicas divisiones del generador se ejecutan aquí, una vez.
+ * Los intervalos son de 16 bits: por debajo de @ref STEPPER_RAMP_MIN_SPS el cociente
+ * F / start_sps no entra en c_start y se truncaría a un intervalo corto (el motor
+ * arrancaría muy por encima del pull-in), por eso la velocidad se eleva a ese mínimo.
+ */
+void Stepper_Ramp_Init(Stepper_Ramp_t* hramp, uint16_t start_sps, uint16_t max_sps, uint16_t accel_sps2) {
+    if (start_sps < STEPPER_RAMP_MIN_SPS) start_sps = STEPPER_RAMP_MIN_SPS;
+    if (max_sps < start_sps) max_sps = start_sps;
+
+    hramp->c_start = (uint16_t)(STEPPER_TIMER_HZ / start_sps);
+    hramp->c_min   = (uint16_t)(STEPPER_TIMER_HZ / max_sps);
+    hramp->v_start = 0xFFFFFFFFUL / hramp->c_start;
+    hramp->v_max   = 0xFFFFFFFFUL / hramp->c_min;
+    hramp->accel_k = (uint32_t)accel_sps2 * STEPPER_RAMP_K;
+
+    hramp->v           = hramp->v_start;
+    hramp->c           = hramp->c_start;
+    hramp->steps_left  = 0;
+    hramp->accel_steps = 0;
+    hramp->continuous  = false;
+    hramp->state       = RAMP_IDLE;
+}
+
+/**
+ * @brief Arranca el perfil desde la velocidad de pull-in.
+ */
+static void Ramp_Start(Stepper_Ramp_t* hramp, uint32_t steps, bool continuous) {
+    uint8_t sreg = SREG;
+    cli();
+    if (hramp->state == RAMP_IDLE) {
+        hramp->v           = hramp->v_start;
+        hramp->c           = hramp->c_start;
+        hramp->accel_steps = 0;
+        hramp->state       = (hramp->v_max > hramp->v_start) ? RAMP_ACCEL : RAMP_CRUISE;
     }
-}
\ No newline at end of file
+    hramp->steps_left = steps;
+    hramp->continuous = continuous;
+    SREG = sreg;
+}
+
+void Stepper_Ramp_Move(Stepper_Ramp_t* hramp, uint32_t steps) {
+    if (steps == 0) return;
+    Ramp_Start(hramp, steps, false);
+}
+
+void Stepper_Ramp_Run(Stepper_Ramp_t* hramp) {
+    Ramp_Start(hramp, 0, true);
+}
+
+/**
+ * @brief Agrega pasos al movimiento en curso (usado por el planificador multi-eje).
+ * @details Si la fase era de frenado y ahora sobran pasos, se retoma la aceleración;
+ * si el motor ya estaba en crucero, RAMP_ACCEL lo detecta en el siguiente paso.
+ */
+void Stepper_Ramp_Extend(Stepper_Ramp_t* hramp, uint32_t steps) {
+    if (steps == 0) return;
+
+    uint8_t sreg = SREG;
+    cli();
+    if (hramp->state == RAMP_IDLE || hramp->continuous) {
+        SREG = sreg;
+        if (hramp->state == RAMP_IDLE) Stepper_Ramp_Move(hramp, steps);
+        return;
+    }
+    hramp->steps_left += steps;
+    if (hramp->state == RAMP_DECEL && hramp->steps_left > hramp->accel_steps) {
+        hramp->state = RAMP_ACCEL;
+    }
+    SREG = sreg;
+}
+
+/**
+ * @brief Convierte el movimiento en curso en un frenado simétrico a la aceleración.
+ * @details Quedan tantos pasos como los usados para acelerar (+1 por el paso en curso).
+ */
+void Stepper_Ramp_Stop(Stepper_Ramp_t* hramp) {
+    uint8_t sreg = SREG;
+    cli();
+    if (hramp->state != RAMP_IDLE) {
+        uint32_t brake = hramp->accel_steps + 1;
+        if (hramp->continuous || hramp->steps_left > brake) {
+            hramp->steps_left = brake;
+        }
+        hramp->continuous = false;
+    }
+    SREG = sreg;
+}
+
+bool Stepper_Ramp_IsRunning(const Stepper_Ramp_t* hramp) {
+    return hramp->state != RAMP_IDLE;
+}
+
+/**
+ * @brief Avanza el perfil un paso y devuelve el intervalo hasta el siguiente.
+ * @details 
+ * 1. Incremento de velocidad: dV = a·c/F² escalado = (accel_k · c) >> 16.
+ * 2. Nuevo intervalo por @ref Ramp_Reciprocal (Newton, sin división).
+ * 3. El frenado comienza cuando los pasos restantes igualan a los de aceleración.
+ * * Costo acotado: dos productos 32x16 y uno 16x16 por paso, en cualquier fase.
+ */
+uint16_t Stepper_Ramp_Tick(Stepper_Ramp_t* hramp) {
+    if (hramp->state == RAMP_IDLE) return 0;
+
+    if (!hramp->continuous) {
+        if (--hramp->steps_left == 0) {
+            hramp->state = RAMP_IDLE;
+            return 0;
+        }
+        if (hramp->steps_left <= hramp->accel_steps) {
+            hramp->state = RAMP_DECEL;
+        }
+    }
+
+    uint32_t dv = Ramp_Mul_Shr16(hramp->accel_k, hramp->c);
+
+    switch (hramp->state) {
+        case RAMP_ACCEL:
+            hramp->accel_steps++;
+            hramp->v += dv;
+            if (hramp->v >= hramp->v_max) {
+                hramp->v     = hramp->v_max;
+                hramp->c     = hramp->c_min;
+                hramp->state = RAMP_CRUISE;
+                return hramp->c;
+            }
+            break;
+
+        case RAMP_DECEL:
+            if (hramp->accel_steps) hramp->accel_steps--;
+            if (hramp->v > hramp->v_start + dv) {
+                hramp->v -= dv;
+            } else {
+                hramp->v = hramp->v_start;
+                hramp->c = hramp->c_start;
+                return hramp->c;
+            }
+            break;
+
+        default: /* RAMP_CRUISE */
+            return hramp->c;
+    }
+
+    uint16_t c = Ramp_Reciprocal(hramp->v, hramp->c);
+    if (c < hramp->c_min)   c = hramp->c_min;
+    if (c > hramp->c_start) c = hramp->c_start;
+    hramp->c = c;
+    return c;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file stepdir_driver.c
+ * @brief Implementación del generador STEP/DIR por hardware (Timer 1, CTC + Toggle).
+ * @author Mamani Flores Carlos
+ * @date 2026
+ * * @details
+ * 1. El pin OC1A conmuta en cada Match: periodo de paso = 2 * (OCR1A + 1) ticks.
+ * 2. En giro continuo la interrupción de comparación permanece deshabilitada.
+ * 3. Un cambio de velocidad habilita la interrupción por un único Match; allí el TCNT1
+ * acaba de volver a 0, por lo que escribir el nuevo TOP nunca lo deja por debajo del
+ * contador (lo que en CTC provocaría una vuelta completa de 65536 ticks).
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "stepdir_driver.h"
+
+/**
+ * @brief Convierte pasos/s al valor de TOP (medio periodo menos 1).
+ */
+static uint16_t StepDir_Top(const StepDir_t* hdrv, uint16_t sps) {
+    if (sps == 0) sps = 1;
+    uint32_t half = hdrv->timer_hz / (2UL * sps);
+    if (half == 0) half = 1;
+    if (half > 65536UL) half = 65536UL;
+    return (uint16_t)(half - 1);
+}
+
+/**
+ * @brief Inicializa el Timer 1 (CTC detenido), el pin STEP (PB1) y el pin DIR.
+ * * @note Implementa aritmética de punteros: la dirección del DDRx es (PORTx - 1).
+ */
+void StepDir_Init(StepDir_t* hdrv, volatile uint8_t* dir_port, uint8_t dir_pin, t1_prescaler_t prescaler) {
+    static const uint16_t divider[] = {1, 1, 8, 64, 256, 1024};
+
+    hdrv->dir_port  = dir_port;
+    hdrv->dir_pin   = dir_pin;
+    hdrv->prescaler = (prescaler >= T1_CLK_1 && prescaler <= T1_CLK_1024) ? prescaler : T1_CLK_8;
+    hdrv->timer_hz  = F_CPU / divider[hdrv->prescaler];
+
+    hdrv->update_pending = false;
+    hdrv->counted        = false;
+    hdrv->running        = false;
+    hdrv->edges_left     = 0;
+
+    /* Pin DIR como salida */
+    *(dir_port - 1) |= (1 << dir_pin);
+
+    /* Pin STEP (OC1A / PB1) como salida en LOW */
+    PORTB &= ~(1 << PORTB1);
+    DDRB  |= (1 << DDB1);
+
+    /* CTC configurado pero sin reloj y con el pin desconectado */
+    Timer1_CTC_Init(T1_OFF, T1_PIN_DISCONNECT, T1_PIN_DISCONNECT, 0xFFFF);
+    hdrv->pending_top = 0xFFFF;
+}
+
+void StepDir_SetDirection(StepDir_t* hdrv, Step_Dir_t dir) {
+    if (dir == STEP_CCW) *(hdrv->dir_port) |= (1 << hdrv->dir_pin);
+    else                 *(hdrv->dir_port) &= ~(1 << hdrv->dir_pin);
+}
+
+/**
+ * @brief Cambia la velocidad del tren de pulsos.
+ * @details Detenido: se escribe OCR1A directamente. En marcha: se deja pendiente y se
+ * habilita la interrupción para aplicarlo en la siguiente coincidencia.
+ */
+void StepDir_SetSpeed(StepDir_t* hdrv, uint16_t sps) {
+    uint16_t top = StepDir_Top(hdrv, sps);
+
+    uint8_t sreg = SREG;
+    cli();
+    hdrv->pending_top = top;
+    if (hdrv->running) {
+        hdrv->update_pending = true;
+        /* Un Match viejo (interrupción deshabilitada) aplicaría el TOP antes de tiempo.
+         * Si ya estaba habilitada (modo contado) el flag es un flanco real: se conserva. */
+        if (!(TIMSK1 & (1 << OCIE1A))) {
+            TIFR1 = (1 << OCF1A);
+            Timer1_Enable_COMPA_INT();
+        }
+    } else {
+        Timer1_Reload_AlarmA(top);
+    }
+    SREG = sreg;
+}
+
+/**
+ * @brief Conecta OC1A en modo Toggle y arranca el reloj desde TCNT1 = 0.
+ */
+static void StepDir_Start(StepDir_t* hdrv, bool counted, uint32_t edges) {
+    uint8_t sreg = SREG;
+    cli();
+    if (!hdrv->running) {
+        Timer1_Reload_AlarmA(hdrv->pending_top);
+        hdrv->update_pending = false;
+        Timer1_Write_Counter(0);
+        Timer1_Set_OutputA(T1_PIN_TOGGLE);
+        Timer1_Set_Clock(hdrv->prescaler);
+        hdrv->running = true;
+    }
+    hdrv->counted    = counted;
+    hdrv->edges_left = edges;
+    if (counted || hdrv->update_pending) {
+        TIFR1 = (1 << OCF1A);       /* Descarta un Match previo pendiente */
+        Timer1_Enable_COMPA_INT();
+    } else {
+        Timer1_Disable_COMPA_INT();
+    }
+    SREG = sreg;
+}
+
+void StepDir_Run(StepDir_t* hdrv) {
+    StepDir_Start(hdrv, false, 0);
+}
+
+void StepDir_Move(StepDir_t* hdrv, uint32_t steps) {
+    if (steps == 0) return;
+    StepDir_Start(hdrv, true, steps * 2UL);
+}
+
+/**
+ * @brief Detiene el tren de pulsos y deja el pin STEP en LOW.
+ * @details Si se detiene a mitad de un pulso, el latch de OC1A puede quedar en HIGH;
+ * se lo fuerza a LOW con un Match forzado (FOC1A) en modo Clear antes de desconectarlo.
+ */
+void StepDir_Stop(StepDir_t* hdrv) {
+    uint8_t sreg = SREG;
+    cli();
+    Timer1_Set_Clock(T1_OFF);
+    Timer1_Disable_COMPA_INT();
+    Timer1_Set_OutputA(T1_PIN_CLEAR);
+    Timer1_Force_CompareA();
+    Timer1_Set_OutputA(T1_PIN_DISCONNECT);
+    hdrv->running        = false;
+    hdrv->counted        = false;
+    hdrv->update_pending = false;
+    SREG = sreg;
+}
+
+bool StepDir_IsRunning(const StepDir_t* hdrv) {
+    return hdrv->running;
+}
+
+/**
+ * @brief Manejador de la coincidencia (TCNT1 recién reiniciado a 0).
+ * @details Aplica un cambio de velocidad pendiente y descuenta flancos. En giro
+ * continuo, una vez aplicado el cambio la interrupción se vuelve a deshabilitar.
+ */
+void StepDir_IRQHandler(StepDir_t* hdrv) {
+    if (hdrv->update_pending) {
+        Timer1_Reload_AlarmA(hdrv->pending_top);
+        hdrv->update_pending = false;
+
+        /* Latencia mayor al nuevo periodo: se evita la vuelta completa del contador */
+        if (Timer1_Read_Counter() >= hdrv->pending_top) {
+            Timer1_Write_Counter(0);
+        }
+    }
+
+    if (hdrv->counted) {
+        if (--hdrv->edges_left == 0) {
+            /* Número par de flancos: el latch de OC1A ya está en LOW */
+            Timer1_Set_Clock(T1_OFF);
+            Timer1_Set_OutputA(T1_PIN_DISCONNECT);
+            Timer1_Disable_COMPA_INT();
+            hdrv->counted = false;
+            hdrv->running = false;
+        }
+    } else {
+        Timer1_Disable_COMPA_INT();
+    }
+}
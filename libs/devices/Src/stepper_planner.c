@@ -0,0 +1,169 @@
+/**
+ * @file stepper_planner.c
+ * @brief Implementación del planificador de movimiento coordinado multi-eje.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ * * @details
+ * 1. Cada segmento se precalcula al encolarse (pasos absolutos, sentidos y eje dominante).
+ * 2. La ISR emite un paso del eje dominante por interrupción y decide con Bresenham qué
+ * ejes secundarios avanzan: una suma y una comparación de 16 bits por eje.
+ * 3. Lookahead: los segmentos consecutivos que no invierten el sentido de ningún eje se
+ * suman a una misma rampa (Stepper_Ramp_Extend), por lo que el frenado solo comienza
+ * cuando los pasos restantes de toda la cola igualan a los de aceleración.
+ */
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "stepper_planner.h"
+
+/** @brief Máscara para el índice circular de la cola (requiere potencia de 2). */
+#define PLANNER_QUEUE_MASK      (PLANNER_QUEUE_LEN - 1)
+
+/**
+ * @brief Asocia los motores al planificador y configura el perfil de velocidad.
+ */
+void Planner_Init(Stepper_Planner_t* hplanner, Stepper_t* axes[], uint8_t n_axes,
+                  uint16_t start_sps, uint16_t max_sps, uint16_t accel_sps2) {
+    if (n_axes > PLANNER_MAX_AXES) n_axes = PLANNER_MAX_AXES;
+
+    for (uint8_t i = 0; i < n_axes; i++) {
+        hplanner->axis[i] = axes[i];
+    }
+    hplanner->n_axes = n_axes;
+
+    Stepper_Ramp_Init(&hplanner->ramp, start_sps, max_sps, accel_sps2);
+
+    hplanner->head        = 0;
+    hplanner->tail        = 0;
+    hplanner->chain_open  = false;
+    hplanner->last_dir    = 0;
+    hplanner->last_moving = 0;
+    hplanner->busy        = false;
+}
+
+/**
+ * @brief Encola un movimiento lineal relativo.
+ * @details La cola es de un solo productor (aplicación) y un solo consumidor (ISR):
+ * el segmento se escribe completo antes de publicar el nuevo 'head'. La publicación y
+ * la extensión de la rampa se hacen en sección crítica para que la ISR vea ambas juntas.
+ */
+bool Planner_Enqueue(Stepper_Planner_t* hplanner, const int16_t delta[]) {
+    Planner_Segment_t seg;
+    uint8_t moving = 0;
+
+    seg.events   = 0;
+    seg.dir_mask = 0;
+
+    /* 1. Pasos absolutos, sentidos y eje dominante */
+    for (uint8_t i = 0; i < hplanner->n_axes; i++) {
+        uint16_t steps;
+        if (delta[i] < 0) {
+            seg.dir_mask |= (1 << i);
+            steps = (uint16_t)(-(int32_t)delta[i]);
+        } else {
+            steps = (uint16_t)delta[i];
+        }
+        seg.steps[i] = steps;
+        if (steps) moving |= (1 << i);
+        if (steps > seg.events) seg.events = steps;
+    }
+
+    if (seg.events == 0) return true;
+
+    /* 2. Un eje que invierte su sentido no puede hacerlo a velocidad de crucero */
+    seg.stop_before = ((seg.dir_mask ^ hplanner->last_dir) & moving & hplanner->last_moving) != 0;
+
+    uint8_t next = (hplanner->head + 1) & PLANNER_QUEUE_MASK;
+    if (next == hplanner->tail) return false;
+
+    hplanner->queue[hplanner->head] = seg;
+
+    /* 3. Publicación del segmento y encadenamiento con la rampa en curso */
+    uint8_t sreg = SREG;
+    cli();
+    hplanner->head = next;
+    if (seg.stop_before) {
+        hplanner->chain_open = false;
+    } else if (hplanner->chain_open) {
+        Stepper_Ramp_Extend(&hplanner->ramp, seg.events);
+    }
+    SREG = sreg;
+
+    hplanner->last_dir    = seg.dir_mask;
+    hplanner->last_moving = moving;
+    return true;
+}
+
+bool Planner_IsIdle(const Stepper_Planner_t* hplanner) {
+    return !hplanner->busy && (hplanner->head == hplanner->tail);
+}
+
+/**
+ * @brief Inicia una nueva rampa que cubre todos los segmentos encadenables.
+ * @details Suma los pasos dominantes desde 'tail' hasta el primer segmento que exige
+ * detenerse (o el final de la cola). Si la cola se agota, la rampa queda abierta y
+ * los segmentos que se encolen después la extenderán.
+ */
+static void Planner_Start_Chain(Stepper_Planner_t* hplanner) {
+    uint32_t chain = 0;
+    uint8_t  i = hplanner->tail;
+
+    do {
+        chain += hplanner->queue[i].events;
+        i = (i + 1) & PLANNER_QUEUE_MASK;
+    } while (i != hplanner->head && !hplanner->queue[i].stop_before);
+
+    hplanner->chain_open = (i == hplanner->head);
+    Stepper_Ramp_Move(&hplanner->ramp, chain);
+}
+
+/**
+ * @brief Carga el próximo segmento de la cola como segmento en ejecución.
+ * @note Los acumuladores arrancan en la mitad del eje dominante para centrar los pasos.
+ */
+static void Planner_Load_Segment(Stepper_Planner_t* hplanner) {
+    hplanner->current = hplanner->queue[hplanner->tail];
+    hplanner->tail = (hplanner->tail + 1) & PLANNER_QUEUE_MASK;
+
+    for (uint8_t i = 0; i < hplanner->n_axes; i++) {
+        Stepper_t* m = hplanner->axis[i];
+        m->direction = (hplanner->current.dir_mask & (1 << i)) ? STEP_CCW : STEP_CW;
+        m->is_active = true;
+        hplanner->error[i] = hplanner->current.events >> 1;
+    }
+    hplanner->step_index = 0;
+    hplanner->busy = true;
+}
+
+/**
+ * @brief Emite el siguiente paso coordinado.
+ * @details Costo por interrupción: una suma y una comparación por eje, más un único
+ * cálculo de rampa compartido por todos los ejes.
+ */
+uint16_t Planner_IRQHandler(Stepper_Planner_t* hplanner) {
+    if (!hplanner->busy) {
+        if (hplanner->tail == hplanner->head) return 0;
+        if (!Stepper_Ramp_IsRunning(&hplanner->ramp)) {
+            Planner_Start_Chain(hplanner);
+        }
+        Planner_Load_Segment(hplanner);
+    }
+
+    /* Interpolación de Bresenham: el eje dominante avanza siempre */
+    uint16_t events = hplanner->current.events;
+    for (uint8_t i = 0; i < hplanner->n_axes; i++) {
+        uint16_t steps = hplanner->current.steps[i];
+        if (steps == 0) continue;
+        hplanner->error[i] += steps;
+        if (hplanner->error[i] >= events) {
+            hplanner->error[i] -= events;
+            Stepper_Step_Sequential(hplanner->axis[i]);
+        }
+    }
+
+    if (++hplanner->step_index >= events) {
+        hplanner->busy = false;
+    }
+
+    return Stepper_Ramp_Tick(&hplanner->ramp);
+}
@@ -0,0 +1,160 @@
+/**
+ * @file ws2812_driver.c
+ * @brief Implementación del driver WS2812 con bucle de bits temporizado a mano.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. Temporización (16MHz, 62.5ns por ciclo; ST a memoria de I/O = 2 ciclos, el pin
+ * cambia al final de la instrucción):
+ *
+ * | Bit | HIGH             | LOW              | Periodo  | Datasheet WS2812B   |
+ * | :-- | :--------------- | :--------------- | :------- | :------------------ |
+ * | 0   | 6 ciclos (375ns) | 14 ciclos (875ns)| 1.25µs   | T0H 400ns, T0L 850ns (±150ns) |
+ * | 1   | 13 ciclos (812ns)| 6 ciclos (375ns) | 1.19µs   | T1H 800ns, T1L 450ns (±150ns) |
+ *
+ * 2. Entre bytes el LOW del último bit se alarga 5 ciclos (carga del byte siguiente) y
+ * entre LEDs lo que tarde el código C y las ISR pendientes: la tira solo exige que no
+ * supere el tiempo de reset.
+ * 3. Los valores de puerto HIGH/LOW se calculan una vez por LED, así el bucle no hace
+ * lectura-modificación-escritura.
+ * 4. Todos los flancos los genera la misma instrucción (ST Z a la dirección de PORTx en
+ * el espacio de datos). En el ATmega328P ST tarda 2 ciclos y el latch del puerto se
+ * actualiza en el mismo punto de la instrucción para las tres escrituras, por lo que esa
+ * latencia se cancela en los anchos de pulso: solo cuenta la distancia entre los ST.
+ * 5. Registros fijos: el buffer va en X y el puerto en Z (restricciones "x" y "z"), así
+ * el bucle emitido no depende de la asignación del compilador ni compite con Y (puntero
+ * de marco). Los contadores usan r16-r31 ("d") porque se cargan con LDI.
+ *
+ * 6. Listado del bucle con ciclos por instrucción (formato de avr-objdump, desplazamiento
+ * desde el inicio del asm). X y Z son fijos; data, bits, bytes, hi y lo los asigna el
+ * compilador, aquí r18, r19, r20, r24 y r25. Otra asignación solo cambia los bytes de
+ * esas instrucciones, no su orden ni sus ciclos. t = ciclo en que termina la
+ * instrucción, contado desde el fin del ST de subida:
+ *
+ *     off  código  instrucción           ciclos  t bit 0     t bit 1
+ *      0:  43 e0   ldi  r20, 0x03        1
+ *      2:  2d 91   ld   r18, X+          2
+ *      4:  38 e0   ldi  r19, 0x08        1
+ *      6:  80 83   st   Z, r24           2       0 sube      0 sube
+ *      8:  00 00   nop                   1       1           1
+ *      a:  00 00   nop                   1       2           2
+ *      c:  00 00   nop                   1       3           3
+ *      e:  27 ff   sbrs r18, 7           1/2     4           5 (salta el ST)
+ *     10:  90 83   st   Z, r25           2       6 baja      -
+ *     12:  22 0f   lsl  r18              1       7           6
+ *     14:  00 00   nop  (x5, 14 a 1c)    5       12          11
+ *     1e:  90 83   st   Z, r25           2       14          13 baja
+ *     20:  00 00   nop                   1       15          14
+ *     22:  3a 95   dec  r19              1       16          15
+ *     24:  81 f7   brne .-32 (a 6)       2/1     18          17
+ *      6:  80 83   st   Z, r24 (bit sig) 2       20 sube     19 sube
+ *
+ * Bit 0: HIGH 6, LOW 14 (20 ciclos). Bit 1: HIGH 13, LOW 6 (19 ciclos). Al terminar el
+ * byte el BRNE de 24 no salta (1) y sigue:
+ *
+ *     26:  4a 95   dec  r20              1       18          17
+ *     28:  61 f7   brne .-40 (a 2)       2/1     20          19
+ *      2:  2d 91   ld   r18, X+          2       22          21
+ *      4:  38 e0   ldi  r19, 0x08        1       23          22
+ *      6:  80 83   st   Z, r24           2       25 sube     24 sube
+ *
+ * El LOW del último bit de cada byte se alarga 5 ciclos (19 y 11). Con otro compilador
+ * o flags, comparar con avr-objdump -d build/<proyecto>.elf (el bucle suele quedar
+ * integrado en WS2812_Show; buscar el `ld rD, X+`): debe coincidir instrucción por
+ * instrucción salvo los números de registro. Sobre el pin de datos, enviando 0x00 y 0xFF,
+ * un analizador lógico debe mostrar HIGH de 375ns y 812ns y periodos de 1.25µs y 1.19µs.
+ */
+
+#include <avr/interrupt.h>
+#include "ws2812_driver.h"
+
+#if F_CPU != 16000000UL
+#error "ws2812_driver: el bucle de bits está calibrado para F_CPU = 16MHz"
+#endif
+
+void WS2812_Init(WS2812_t* strip, volatile uint8_t* port, uint8_t pin) {
+    strip->port = port;
+    strip->mask = (1 << pin);
+
+    *port       &= ~strip->mask;    /* Línea en LOW: la tira queda en reset */
+    *(port - 1) |= strip->mask;     /* DDRx = PORTx - 1 */
+}
+
+void WS2812_Scale(uint8_t* grb, uint16_t count, uint8_t brightness) {
+    if (brightness == 255) return;
+
+    uint16_t n = count * WS2812_BYTES_PER_LED;
+    for (uint16_t i = 0; i < n; i++) {
+        grb[i] = (uint8_t)(((uint16_t)grb[i] * (brightness + 1)) >> 8);
+    }
+}
+
+/**
+ * @brief Transmite los 3 bytes de un LED. Debe llamarse con interrupciones bloqueadas.
+ * @details Cuenta de ciclos desde el flanco de subida (fin del primer ST):
+ * - 3 NOP + SBRS sin salto + ST lo          -> bit 0 baja en t = 6.
+ * - 3 NOP + SBRS con salto (2)              -> bit 1 sigue en HIGH (t = 5).
+ * - LSL + 5 NOP + ST lo                     -> bit 1 baja en t = 13 (bit 0: t = 14, sin efecto).
+ * - NOP + DEC + BRNE (2) + ST hi            -> siguiente subida 6 ciclos después.
+ * @param port Registro PORTx (en Z).
+ * @param p Puntero a los 3 bytes GRB del LED (en X, post-incremento).
+ * @param hi Valor de PORTx con el pin en HIGH.
+ * @param lo Valor de PORTx con el pin en LOW.
+ */
+static void WS2812_Send_LED(volatile uint8_t* port, const uint8_t* p, uint8_t hi, uint8_t lo) {
+    uint8_t data, bits, bytes;
+
+    __asm__ __volatile__ (
+        "    ldi  %[bytes], 3         \n\t"
+        "1:  ld   %[data], %a[ptr]+   \n\t"   /* 2  Byte siguiente (MSB primero) */
+        "    ldi  %[bits], 8          \n\t"   /* 1 */
+        "2:  st   %a[port], %[hi]     \n\t"   /* 2  t = 0: flanco de subida */
+        "    nop                      \n\t"   /* 1  t = 1 */
+        "    nop                      \n\t"   /* 1  t = 2 */
+        "    nop                      \n\t"   /* 1  t = 3 */
+        "    sbrs %[data], 7          \n\t"   /* 1/2 bit = 1: salta el ST */
+        "    st   %a[port], %[lo]     \n\t"   /* 2  bit 0: baja en t = 6 */
+        "    lsl  %[data]             \n\t"   /* 1 */
+        "    nop                      \n\t"   /* 1 */
+        "    nop                      \n\t"   /* 1 */
+        "    nop                      \n\t"   /* 1 */
+        "    nop                      \n\t"   /* 1 */
+        "    nop                      \n\t"   /* 1 */
+        "    st   %a[port], %[lo]     \n\t"   /* 2  bit 1: baja en t = 13 */
+        "    nop                      \n\t"   /* 1 */
+        "    dec  %[bits]             \n\t"   /* 1 */
+        "    brne 2b                  \n\t"   /* 2  (1 al terminar el byte) */
+        "    dec  %[bytes]            \n\t"   /* 1 */
+        "    brne 1b                  \n\t"   /* 2  (1 al terminar el LED) */
+        : [ptr]   "+x" (p),
+          [data]  "=&r" (data),
+          [bits]  "=&d" (bits),
+          [bytes] "=&d" (bytes)
+        : [port]  "z" (port),
+          [hi]    "r" (hi),
+          [lo]    "r" (lo)
+        : "memory"
+    );
+}
+
+/**
+ * @brief Envía LED por LED, con una sección crítica por LED.
+ * @details El apagón de interrupciones queda acotado a 24 bits (~480 ciclos, 30µs) sin
+ * importar el largo de la tira.
+ */
+void WS2812_Show(const WS2812_t* strip, const uint8_t* grb, uint16_t count) {
+    volatile uint8_t* port = strip->port;
+    uint8_t mask = strip->mask;
+
+    while (count--) {
+        uint8_t sreg = SREG;
+        cli();
+
+        uint8_t lo = *port & ~mask;
+        WS2812_Send_LED(port, grb, lo | mask, lo);
+
+        SREG = sreg;
+        grb += WS2812_BYTES_PER_LED;
+    }
+}
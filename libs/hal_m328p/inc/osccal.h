@@ -0,0 +1,59 @@
+/**
+ * @file osccal.h
+ * @brief Auto-calibración del oscilador RC interno (OSCCAL) contra el cristal de 32.768 kHz.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details El RC interno de 8 MHz tiene una tolerancia de fábrica de ±10%. Este módulo
+ * cuenta ciclos de CPU con el Timer 1 (clk/1) durante una ventana fija de 1/256 s
+ * medida por el Timer 2 asíncrono (cristal de reloj en TOSC1/TOSC2) y ajusta OSCCAL
+ * por búsqueda binaria hasta quedar dentro de ±0.5% de F_CPU.
+ * * @note Requiere fuses de RC interno (lfuse 0xE2, ver projects/00_Fuses_Config) y el
+ * cristal de 32.768 kHz en PB6/PB7. Es compatible con el módulo RTC (prescaler 128).
+ */
+
+#ifndef OSCCAL_H_
+#define OSCCAL_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Ciclos de CPU esperados en la ventana de medición (1/256 s). */
+#define OSCCAL_TARGET_CYCLES    ((uint16_t)(F_CPU / 256UL))
+
+/** @brief Error máximo aceptado: 1/200 = 0.5%. */
+#define OSCCAL_TOLERANCE        ((uint16_t)(OSCCAL_TARGET_CYCLES / 200U))
+
+/* --- API Pública --- */
+
+/**
+ * @brief Pone en marcha el Timer 2 asíncrono si todavía no lo está.
+ * @details Si el RTC ya lo configuró, se reutiliza su prescaler sin modificarlo.
+ * @note El cristal puede demorar ~1s en estabilizarse tras el encendido: calibrar antes
+ * de ese tiempo da resultados erráticos.
+ */
+void Osccal_Init(void);
+
+/**
+ * @brief Mide los ciclos de CPU en una ventana de 1/256 s del cristal.
+ * @details Las interrupciones se deshabilitan durante ~4ms y el Timer 1 se usa
+ * temporalmente (su configuración se restaura al terminar).
+ * @return Ciclos medidos (ideal: @ref OSCCAL_TARGET_CYCLES).
+ */
+uint16_t Osccal_Measure(void);
+
+/**
+ * @brief Calibración completa por búsqueda binaria sobre OSCCAL.
+ * @return true si el error final es menor a @ref OSCCAL_TOLERANCE.
+ */
+bool Osccal_Calibrate(void);
+
+/**
+ * @brief Corrección incremental (±1 paso de OSCCAL) para seguir la deriva térmica.
+ * @details Pensada para invocarse periódicamente (ej. una vez por minuto) desde el loop.
+ * @return Error relativo actual en ciclos (medido - esperado), antes de corregir.
+ */
+int16_t Osccal_Retrim(void);
+
+#endif /* OSCCAL_H_ */
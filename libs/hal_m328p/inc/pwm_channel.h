@@ -0,0 +1,70 @@
+/**
+ * @file pwm_channel.h
+ * @brief Descriptor genérico de canal PWM: acceso directo al registro OCRnx.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details Un canal PWM queda identificado por la dirección de su registro de comparación.
+ * Con un canal constante (@ref PWM_CH_T0A, etc.) la macro @ref PWM_WRITE se reduce a una
+ * única instrucción OUT/STS; guardado en una estructura (forma puntero) la escritura es
+ * un ST indirecto, sin llamadas a función ni bifurcaciones por canal.
+ * * @note Los canales de 8 bits (Timer 0 y 2) y de 16 bits (Timer 1) tienen tipos distintos
+ * para que el compilador detecte mezclas de resolución.
+ */
+
+#ifndef PWM_CHANNEL_H_
+#define PWM_CHANNEL_H_
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdint.h>
+
+/** @brief Canal de 8 bits (OCR0A/B, OCR2A/B). */
+typedef volatile uint8_t*  pwm8_channel_t;
+
+/** @brief Canal de 16 bits (OCR1A/B). */
+typedef volatile uint16_t* pwm16_channel_t;
+
+/** * @name Canales de Hardware (constantes de compilación)
+ * @{
+ */
+#define PWM_CH_T0A  (&OCR0A)  /**< Timer 0, canal A - PD6 */
+#define PWM_CH_T0B  (&OCR0B)  /**< Timer 0, canal B - PD5 */
+#define PWM_CH_T1A  (&OCR1A)  /**< Timer 1, canal A - PB1 (16 bits) */
+#define PWM_CH_T1B  (&OCR1B)  /**< Timer 1, canal B - PB2 (16 bits) */
+#define PWM_CH_T2A  (&OCR2A)  /**< Timer 2, canal A - PB3 */
+#define PWM_CH_T2B  (&OCR2B)  /**< Timer 2, canal B - PD3 */
+/** @} */
+
+/**
+ * @brief Escritura sobre un canal constante (forma macro).
+ * @details Con un canal de 8 bits se resuelve en una sola instrucción. Para canales de
+ * 16 bits escritos también desde una ISR usar @ref PWM16_Write (registro TEMP compartido).
+ */
+#define PWM_WRITE(ch, val)  (*(ch) = (val))
+
+/* --- API Pública (forma puntero) --- */
+
+/**
+ * @brief Escribe el duty en un canal de 8 bits.
+ * @param ch Canal (dirección del OCR).
+ * @param duty Valor de 0 a 255.
+ */
+static inline void PWM8_Write(pwm8_channel_t ch, uint8_t duty) { *ch = duty; }
+
+/**
+ * @brief Escribe el valor de comparación en un canal de 16 bits.
+ * @details El Timer 1 usa un único registro TEMP para el byte alto de todos sus registros
+ * de 16 bits: la escritura se protege para que una ISR que acceda a otro registro del
+ * Timer 1 no corrompa el valor a mitad de camino.
+ * @param ch Canal (dirección del OCR).
+ * @param val Valor de comparación (0 a TOP).
+ */
+static inline void PWM16_Write(pwm16_channel_t ch, uint16_t val) {
+    uint8_t sreg = SREG;
+    cli();
+    *ch = val;
+    SREG = sreg;
+}
+
+#endif /* PWM_CHANNEL_H_ */
@@ -0,0 +1,77 @@
+/**
+ * @file pwm_fade.h
+ * @brief Núcleo común de fundidos (fades) para los drivers de PWM por hardware.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details Un fundido interpola el registro de comparación desde su valor actual hasta un
+ * objetivo a lo largo de N periodos de PWM. Cada driver (Timer 0, 1 y 2) avanza sus canales
+ * desde la ISR de Overflow del propio Timer: como en Fast PWM los OCRnx tienen doble
+ * buffer y se actualizan en BOTTOM, la escritura nunca produce un pulso truncado y el loop
+ * principal no interviene.
+ * * @note El progreso se lleva en un acumulador de 32 bits cuyo incremento se calcula al
+ * iniciar el fundido (única división); la ISR solo suma, busca en la tabla y multiplica.
+ */
+
+#ifndef PWM_FADE_H_
+#define PWM_FADE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @enum pwm_fade_curve_t
+ * @brief Forma del fundido.
+ */
+typedef enum {
+    PWM_FADE_LINEAR = 0, /**< Incremento constante del duty. */
+    PWM_FADE_EXP    = 1  /**< Exponencial (tabla en FLASH): brillo percibido lineal. */
+} pwm_fade_curve_t;
+
+/**
+ * @struct PWM_Fade_t
+ * @brief Estado de un fundido en curso (uno por canal).
+ */
+typedef struct {
+    uint16_t      from;    /**< Valor de comparación al iniciar. */
+    uint16_t      to;      /**< Valor objetivo. */
+    uint32_t      acc;     /**< Progreso Q0.32 (0 = inicio, 2^32 = fin). */
+    uint32_t      inc;     /**< Incremento de progreso por periodo de PWM. */
+    uint8_t       curve;   /**< @ref pwm_fade_curve_t. */
+    bool          bounce;  /**< true: al terminar invierte from/to y repite (respiración). */
+    volatile bool active;  /**< Fundido en curso. */
+} PWM_Fade_t;
+
+/* --- API Pública --- */
+
+/**
+ * @brief Prepara un fundido. Debe invocarse con la ISR del Timer bloqueada.
+ * @param fade Estado del canal.
+ * @param from Valor actual del registro de comparación.
+ * @param to Valor objetivo.
+ * @param periods Duración expresada en periodos de PWM (0 = salto inmediato).
+ * @param curve Forma del fundido.
+ * @param bounce Repetir ida y vuelta indefinidamente.
+ */
+void PWM_Fade_Start(PWM_Fade_t* fade, uint16_t from, uint16_t to, uint32_t periods,
+                    pwm_fade_curve_t curve, bool bounce);
+
+/**
+ * @brief Avanza un periodo. Pensada para la ISR de Overflow.
+ * @param fade Estado del canal.
+ * @param out Nuevo valor a escribir en el OCR.
+ * @return true si hay un valor que escribir (el fundido estaba activo).
+ */
+bool PWM_Fade_Step(PWM_Fade_t* fade, uint16_t* out);
+
+/**
+ * @brief Convierte milisegundos a periodos de PWM.
+ * @param ms Duración en milisegundos.
+ * @param ovf_hz Frecuencia de Overflow del Timer (periodos por segundo).
+ */
+static inline uint32_t PWM_Fade_Periods(uint16_t ms, uint32_t ovf_hz) {
+    /* Separado en parte entera y resto para no desbordar 32 bits con ovf_hz altos */
+    return (ovf_hz / 1000UL) * ms + ((ovf_hz % 1000UL) * ms) / 1000UL;
+}
+
+#endif /* PWM_FADE_H_ */
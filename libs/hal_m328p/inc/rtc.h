@@ -0,0 +1,78 @@
+/**
+ * @file rtc.h
+ * @brief Reloj de Tiempo Real (RTC) sobre el Timer 2 asíncrono (cristal de 32.768 kHz).
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details El Timer 2, clockeado por un cristal de reloj en TOSC1/TOSC2 y con prescaler
+ * 128, desborda exactamente una vez por segundo (32768 / 128 / 256 = 1 Hz). Como su
+ * reloj no depende del CPU, sigue contando en modo Power-save: el MCU duerme entre
+ * segundos y el consumo en reposo baja de mA a µA.
+ * * @note Con el cristal en TOSC1/TOSC2 (PB6/PB7) el MCU debe funcionar con el oscilador
+ * RC interno (ver projects/00_Fuses_Config).
+ */
+
+#ifndef RTC_H_
+#define RTC_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @struct RTC_Time_t
+ * @brief Fecha y hora del calendario.
+ */
+typedef struct {
+    uint8_t  second;  /**< 0-59 */
+    uint8_t  minute;  /**< 0-59 */
+    uint8_t  hour;    /**< 0-23 */
+    uint8_t  day;     /**< 1-31 */
+    uint8_t  month;   /**< 1-12 */
+    uint16_t year;    /**< Año completo (ej. 2026) */
+} RTC_Time_t;
+
+/* --- API Pública --- */
+
+/**
+ * @brief Conmuta el Timer 2 al cristal de 32.768 kHz y arma el tick de 1 segundo.
+ * @details Aplica la secuencia segura de conmutación asíncrona (ver timer2_normal.c)
+ * antes de habilitar la interrupción de Overflow.
+ * @note La aplicación debe invocar @ref RTC_IRQHandler desde ISR(TIMER2_OVF_vect).
+ */
+void RTC_Init(void);
+
+/**
+ * @brief Manejador del tick de 1 segundo. Debe llamarse desde ISR(TIMER2_OVF_vect).
+ */
+void RTC_IRQHandler(void);
+
+/**
+ * @brief Carga fecha y hora (atómico respecto del tick).
+ */
+void RTC_SetTime(const RTC_Time_t* time);
+
+/**
+ * @brief Copia fecha y hora actuales (atómico respecto del tick).
+ */
+void RTC_GetTime(RTC_Time_t* time);
+
+/**
+ * @brief Segundos transcurridos desde @ref RTC_Init (lectura atómica de 32 bits).
+ */
+uint32_t RTC_GetSeconds(void);
+
+/**
+ * @brief Indica si hubo un tick desde la última llamada (y consume el aviso).
+ */
+bool RTC_TickPending(void);
+
+/**
+ * @brief Duerme en modo Power-save hasta el próximo tick (u otra interrupción).
+ * @details Sincroniza el dominio asíncrono antes de dormir, apaga el ADC y el BOD
+ * durante el sueño y usa la secuencia cli/sleep_enable/sei/sleep_cpu para no perder
+ * un tick que llegue entre la verificación y la instrucción SLEEP.
+ */
+void RTC_Sleep(void);
+
+#endif /* RTC_H_ */
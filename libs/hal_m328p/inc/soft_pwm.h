@@ -0,0 +1,86 @@
+/**
+ * @file soft_pwm.h
+ * @brief Motor de PWM por software con Bit-Angle Modulation (BAM) sobre el Timer 1.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details Extiende las 6 salidas PWM por hardware a cualquier pin libre de los puertos
+ * B, C y D. El periodo se divide en 8 ranuras cuyo largo es proporcional al peso del bit
+ * (1, 2, 4 ... 128 unidades); en cada ranura todos los canales muestran el bit
+ * correspondiente de su duty. Una interrupción por ranura (8 por periodo) escribe tres
+ * bytes de puerto precalculados, así que la carga de CPU es constante e independiente
+ * de la cantidad de canales.
+ * * @note Con F_CPU = 16MHz, reloj clk/8 y @ref SOFT_PWM_UNIT_TICKS = 64, el periodo es
+ * 255 * 32µs = 8.16ms (122Hz) con 8 bits de resolución; la ranura más corta (32µs =
+ * 512 ciclos) acota la latencia tolerable de otras ISR. Ocupa el Timer 1 completo.
+ */
+
+#ifndef SOFT_PWM_H_
+#define SOFT_PWM_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "timer1_normal.h"
+
+/** @brief Cantidad máxima de canales (todos los pines de B, C y D). */
+#define SOFT_PWM_MAX_CHANNELS   24U
+
+/** @brief Resolución fija del BAM (8 bits: 8 ranuras). */
+#define SOFT_PWM_BITS           8U
+
+/**
+ * @brief Ticks del Timer 1 (clk/8) de la ranura de peso 1.
+ * @details Frecuencia de refresco = F_CPU / 8 / (255 * SOFT_PWM_UNIT_TICKS).
+ * La ranura de peso 128 debe caber en 16 bits (máximo 511).
+ */
+#ifndef SOFT_PWM_UNIT_TICKS
+#define SOFT_PWM_UNIT_TICKS     64U
+#endif
+
+/**
+ * @struct SoftPWM_Pin_t
+ * @brief Pin físico asociado a un canal.
+ */
+typedef struct {
+    volatile uint8_t* port; /**< Registro PORTx (&PORTB, &PORTC o &PORTD). */
+    uint8_t           pin;  /**< Número de pin (0-7). */
+} SoftPWM_Pin_t;
+
+/* --- API Pública --- */
+
+/**
+ * @brief Configura los pines como salida, arma las máscaras de puerto y arranca el Timer 1.
+ * @param pins Tabla de pines; el índice en la tabla es el número de canal.
+ * @param count Cantidad de canales (hasta @ref SOFT_PWM_MAX_CHANNELS).
+ * @note La aplicación debe invocar @ref SoftPWM_IRQHandler desde ISR(TIMER1_COMPA_vect).
+ * @note Un canal con puerto distinto de &PORTB/&PORTC/&PORTD (o NULL) o pin mayor que 7
+ * se rechaza: conserva su número pero no controla ningún pin.
+ */
+void SoftPWM_Init(const SoftPWM_Pin_t* pins, uint8_t count);
+
+/**
+ * @brief Carga el duty de un canal en el buffer de trabajo (sin efecto visible).
+ * @param channel Índice del canal.
+ * @param duty 0 (apagado) a 255 (encendido permanente).
+ */
+void SoftPWM_SetDuty(uint8_t channel, uint8_t duty);
+
+/**
+ * @brief Lee el duty cargado para un canal.
+ */
+uint8_t SoftPWM_GetDuty(uint8_t channel);
+
+/**
+ * @brief Traduce los duties a bytes de puerto y los publica al inicio del próximo periodo.
+ * @details Doble buffer: la ISR nunca ve un cuadro a medio calcular. Si el cuadro
+ * anterior aún no fue tomado, espera (como máximo un periodo) antes de sobrescribirlo.
+ */
+void SoftPWM_Commit(void);
+
+/**
+ * @brief Manejador de ranura. Debe llamarse desde ISR(TIMER1_COMPA_vect).
+ */
+void SoftPWM_IRQHandler(void);
+
+#endif /* SOFT_PWM_H_ */
@@ -14,6 +14,8 @@
 
 #include <avr/io.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "pwm_fade.h"
 
 /**
  * @enum t1_pwm_prescaler_t
@@ -74,4 +76,102 @@ void Timer1_PWM_Fast_SetCompare(t1_pwm_channel_t channel, uint16_t val);
 void Timer1_PWM_IT_Overflow(uint8_t state);
 void Timer1_PWM_IT_CompareMatch(t1_pwm_channel_t channel, uint8_t state);
 
+/* --- API de Fundidos (ISR de Overflow) --- */
+
+/**
+ * @brief Inicia un fundido del canal desde su duty actual hasta 'target'.
+ * @details El OCR se actualiza en cada Overflow desde @ref Timer1_PWM_Fade_IRQHandler; por el
+ * doble buffer del Fast PWM el valor nuevo rige desde el siguiente periodo completo.
+ * Habilita la interrupción de Overflow del Timer.
+ * @param channel Canal A o B.
+ * @param target Duty final (0-TOP).
+ * @param duration_ms Duración del fundido en milisegundos.
+ * @param curve Lineal o exponencial (@ref pwm_fade_curve_t).
+ * @param bounce true: ida y vuelta indefinida entre el duty actual y 'target'.
+ */
+void Timer1_PWM_Fade(t1_pwm_channel_t channel, uint16_t target, uint16_t duration_ms,
+                     pwm_fade_curve_t curve, bool bounce);
+
+/**
+ * @brief Indica si el canal tiene un fundido en curso.
+ */
+bool Timer1_PWM_Fade_IsActive(t1_pwm_channel_t channel);
+
+/**
+ * @brief Detiene el fundido del canal dejando el duty en su valor actual.
+ */
+void Timer1_PWM_Fade_Stop(t1_pwm_channel_t channel);
+
+/**
+ * @brief Avanza los fundidos un periodo. Debe llamarse desde ISR(TIMER1_OVF_vect).
+ */
+void Timer1_PWM_Fade_IRQHandler(void);
+
+/* --- API de Dithering Sigma-Delta (ISR de Overflow) --- */
+
+/**
+ * @struct t1_pwm_dither_t
+ * @brief Estado del modulador. Es público solo para que el handler pueda ser inline;
+ * la aplicación lo modifica únicamente a través de Dither_Set / Dither_Stop.
+ */
+typedef struct {
+    volatile uint16_t integer[2];   /**< Parte entera (ticks) de los canales A y B. */
+    volatile uint16_t frac[2];      /**< Fracción Q.16 de cada canal. */
+    uint16_t          acc[2];       /**< Acumulador del modulador de cada canal. */
+    volatile uint8_t  mask;         /**< Bit 0: canal A, bit 1: canal B. */
+} t1_pwm_dither_t;
+
+extern t1_pwm_dither_t t1_pwm_dither; /**< Instancia única (Timer 1). */
+
+/**
+ * @brief Fija un duty con 16 bits fraccionarios (Q16.16) sobre un canal.
+ * @details La parte entera es el valor de comparación base; la ISR de Overflow aplica un
+ * modulador Sigma-Delta de primer orden a la fracción, alternando OCR1x entre 'n' y 'n+1'
+ * de modo que el promedio de 2^k periodos tenga k bits extra de resolución.
+ * Ejemplo: TOP = 255 a 62.5kHz suma 8 bits efectivos promediando 4ms (ideal para LEDs);
+ * a 50Hz (servo) el promedio de 16 periodos (320ms) suma 4 bits.
+ * @param channel Canal A o B.
+ * @param duty_q16 (ticks << 16) | fracción. La parte entera debe ser menor que TOP.
+ * @note Habilita la interrupción de Overflow. No combinar con un fundido en el mismo canal.
+ */
+void Timer1_PWM_Dither_Set(t1_pwm_channel_t channel, uint32_t duty_q16);
+
+/**
+ * @brief Detiene el dithering del canal dejando OCR1x en la parte entera.
+ */
+void Timer1_PWM_Dither_Stop(t1_pwm_channel_t channel);
+
+/**
+ * @brief Avanza el modulador un periodo. Debe llamarse desde ISR(TIMER1_OVF_vect).
+ * @details Modulador de primer orden: acc += fracción y el acarreo suma un tick. El
+ * error de cuantización queda en 'acc' (siempre menor a un tick) y se compensa en los
+ * periodos siguientes, empujando el ruido a alta frecuencia.
+ * * Es inline para que la ISR no pague una llamada ni, por ella, el guardado de todos los
+ * registros call-clobbered (r18-r27, r30, r31). Costo estimado por conteo de
+ * instrucciones (no medido), con ambos canales activos y la ISR conteniendo solo este
+ * handler:
+ * - Cuerpo: ~60 ciclos (por canal: cargas y suma de 16 bits, acarreo, escritura de
+ * OCR1x en dos bytes, ~27 ciclos).
+ * - Respuesta, prólogo/epílogo y RETI: ~60 ciclos. Total ~120 ciclos por periodo.
+ * - Carga de CPU: 0.04% a 50Hz (servo), 12% a 15.6kHz (TOP = 1023, clk/1) y 47% a
+ * 62.5kHz (TOP = 255, clk/1).
+ * - Si la misma ISR llama a funciones no inline, sumar ~30 ciclos (registros extra y
+ * CALL/RET).
+ * Verificar con: avr-objdump -d app.elf | sed -n '/<__vector_13>:/,/reti/p'.
+ */
+static inline void Timer1_PWM_Dither_IRQHandler(void) {
+    uint8_t mask = t1_pwm_dither.mask;
+
+    if (mask & (1 << T1_PWM_CH_A)) {
+        uint16_t prev = t1_pwm_dither.acc[0];
+        t1_pwm_dither.acc[0] = prev + t1_pwm_dither.frac[0];
+        OCR1A = t1_pwm_dither.integer[0] + (t1_pwm_dither.acc[0] < prev);
+    }
+    if (mask & (1 << T1_PWM_CH_B)) {
+        uint16_t prev = t1_pwm_dither.acc[1];
+        t1_pwm_dither.acc[1] = prev + t1_pwm_dither.frac[1];
+        OCR1B = t1_pwm_dither.integer[1] + (t1_pwm_dither.acc[1] < prev);
+    }
+}
+
 #endif /* TIMER1_FAST_PWM_H_ */
\ No newline at end of file
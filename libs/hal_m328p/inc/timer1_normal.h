@@ -66,6 +66,18 @@ typedef enum {
  */
 void Timer1_Normal_Init(t1_prescaler_t prescaler, t1_comp_mode_t mode_a, t1_comp_mode_t mode_b);
 
+/**
+ * @brief Inicializa el Timer 1 en Modo CTC (Modo 4, TOP = OCR1A).
+ * @details El contador se reinicia al alcanzar OCR1A. Con T1_PIN_TOGGLE en el canal A
+ * se obtiene una onda cuadrada en OC1A (PB1) de frecuencia F_timer / (2 * (top + 1))
+ * generada íntegramente por hardware.
+ * @param prescaler Fuente de reloj (T1_OFF deja el Timer detenido y configurado).
+ * @param mode_a Comportamiento del pin OC1A (PB1) en cada Match.
+ * @param mode_b Comportamiento del pin OC1B (PB2) en cada Match.
+ * @param top Valor de OCR1A (periodo).
+ */
+void Timer1_CTC_Init(t1_prescaler_t prescaler, t1_comp_mode_t mode_a, t1_comp_mode_t mode_b, uint16_t top);
+
 /**
  * @brief Configura la Unidad de Captura de Entrada (Input Capture Unit).
  * @details Permite registrar el valor de TCNT1 en el registro ICR1 ante un evento en el pin ICP1 (PB0).
@@ -79,13 +91,15 @@ void Timer1_InputCapture_Init(bool rising_edge, bool noise_canceller);
  * @note El hardware de AVR asegura la atomicidad mediante un registro temporal de 8 bits interno.
  * @param val Valor de 16 bits (0-65535).
  */
-void Timer1_Write_Counter(uint16_t val);
+static inline void Timer1_Write_Counter(uint16_t val) { TCNT1 = val; }
 
 /**
  * @brief Lee el valor actual del contador de 16 bits.
+ * @note Se declara 'static inline' (igual que en Timer 0 y Timer 2) para que las
+ * esperas activas dentro de una ISR tengan una resolución menor a un tick del Timer.
  * @return uint16_t Valor actual de TCNT1.
  */
-uint16_t Timer1_Read_Counter(void);
+static inline uint16_t Timer1_Read_Counter(void) { return TCNT1; }
 
 /**
  * @brief Configura el punto de comparación para el Canal A (Alarma A).
@@ -99,10 +113,53 @@ void Timer1_Set_AlarmA(uint16_t val);
  */
 void Timer1_Set_AlarmB(uint16_t val);
 
+/**
+ * @brief Reprograma la Alarma A sin modificar la máscara de interrupciones.
+ * @details Pensada para ser usada dentro de ISR(TIMER1_COMPA_vect) con la técnica
+ * de acumulador (OCR1A = base + periodo), donde OCIE1A ya se encuentra habilitado.
+ * @param val Valor de 16 bits para OCR1A.
+ */
+static inline void Timer1_Reload_AlarmA(uint16_t val) { OCR1A = val; }
+
+/**
+ * @brief Reprograma la Alarma B sin modificar la máscara de interrupciones.
+ * @param val Valor de 16 bits para OCR1B.
+ */
+static inline void Timer1_Reload_AlarmB(uint16_t val) { OCR1B = val; }
+
+/**
+ * @brief Cambia la fuente de reloj sin alterar el modo (arranca o detiene el conteo).
+ * @param prescaler Nueva fuente de reloj (T1_OFF detiene el Timer).
+ */
+static inline void Timer1_Set_Clock(t1_prescaler_t prescaler) {
+    TCCR1B = (TCCR1B & ~0x07) | (prescaler & 0x07);
+}
+
+/**
+ * @brief Conecta o desconecta el pin OC1A (PB1) de la lógica de comparación.
+ * @param mode Nuevo comportamiento del pin (@ref t1_comp_mode_t).
+ */
+static inline void Timer1_Set_OutputA(t1_comp_mode_t mode) {
+    TCCR1A = (TCCR1A & ~((1 << COM1A1) | (1 << COM1A0))) | (mode << COM1A0);
+}
+
+/**
+ * @brief Fuerza un Compare Match en el canal A (bit FOC1A).
+ * @details Aplica la acción de COM1A1:0 sobre el pin sin generar interrupción ni
+ * reiniciar el contador. Solo es válido en modos no-PWM (Normal y CTC).
+ */
+static inline void Timer1_Force_CompareA(void) { TCCR1C = (1 << FOC1A); }
+
 /** * @name Gestión de Interrupciones
  * @{ 
  */
 
+/** @brief Habilita la interrupción por Compare Match A. */
+static inline void Timer1_Enable_COMPA_INT(void)  { TIMSK1 |= (1 << OCIE1A); }
+
+/** @brief Deshabilita la interrupción por Compare Match A. */
+static inline void Timer1_Disable_COMPA_INT(void) { TIMSK1 &= ~(1 << OCIE1A); }
+
 /** @brief Habilita la interrupción por desbordamiento (Overflow). */
 static inline void Timer1_Enable_OVF_INT(void)  { TIMSK1 |= (1 << TOIE1); }
 
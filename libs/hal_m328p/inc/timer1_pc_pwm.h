@@ -0,0 +1,127 @@
+/**
+ * @file timer1_pc_pwm.h
+ * @brief Driver de Capa 1 (HAL) para PWM centrado (Phase Correct y Phase & Frequency Correct)
+ * en el Timer 1, con modo complementario y tiempo muerto.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details El contador sube de BOTTOM a TOP (ICR1) y vuelve a bajar, por lo que cada pulso
+ * queda centrado en BOTTOM y la forma de onda es simétrica (menor contenido armónico que
+ * el Fast PWM de @ref timer1_fast_pwm.h).
+ * - Modo 10 (Phase Correct): los OCR1x se cargan desde su buffer en TOP.
+ * - Modo 8 (Phase & Frequency Correct): los OCR1x se cargan en BOTTOM; un cambio de
+ * periodo aplicado en TOP mantiene simétrico cada ciclo (sin glitches al variar la frecuencia).
+ *
+ * Modo complementario (sobre el Modo 10): OC1A (PB1) es la salida del lado alto en modo
+ * Non-Inverting y OC1B (PB2) la del lado bajo en modo Inverting. Con OCR1A = d - dt/2 y
+ * OCR1B = d + dt/2, en cada flanco queda un hueco de 'dt' ticks en el que ambas salidas
+ * están en LOW: el medio puente nunca conduce en cortocircuito.
+ * * @note Frecuencia: F = F_CPU / (2 * N * TOP). Para 20kHz a 16MHz con N = 1, TOP = 400.
+ */
+
+#ifndef TIMER1_PC_PWM_H_
+#define TIMER1_PC_PWM_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+#include "timer1_fast_pwm.h"
+
+/**
+ * @enum t1_pc_mode_t
+ * @brief Modos de PWM centrado con TOP en ICR1 (Table 15-5 del datasheet).
+ */
+typedef enum {
+    T1_PC_PHASE_FREQ = 8,  /**< Phase & Frequency Correct: OCR1x se cargan en BOTTOM. */
+    T1_PC_PHASE      = 10  /**< Phase Correct: OCR1x se cargan en TOP. */
+} t1_pc_mode_t;
+
+/* --- API de Configuración Base --- */
+
+/**
+ * @brief Inicializa el Timer 1 en el modo centrado elegido, con las salidas desconectadas.
+ * @param mode @ref T1_PC_PHASE o @ref T1_PC_PHASE_FREQ.
+ * @param prescaler Fuente de reloj (@ref t1_pwm_prescaler_t).
+ * @param top Valor de ICR1 (define la frecuencia).
+ */
+void Timer1_PC_PWM_Init_Mode(t1_pc_mode_t mode, t1_pwm_prescaler_t prescaler, uint16_t top);
+
+/**
+ * @brief Conecta un canal PWM a su pin físico (PB1 o PB2).
+ * @param channel Canal A o B.
+ * @param mode Non-Inverting (alto alrededor de BOTTOM) o Inverting.
+ */
+void Timer1_PC_PWM_EnableChannel(t1_pwm_channel_t channel, t1_pwm_mode_t mode);
+
+/**
+ * @brief Desconecta el canal, devolviendo el pin al control del GPIO.
+ */
+void Timer1_PC_PWM_DisableChannel(t1_pwm_channel_t channel);
+
+/**
+ * @brief Escribe el valor de comparación de un canal (0 a TOP).
+ * @note El hardware lo aplica en TOP (Modo 10) o en BOTTOM (Modo 8).
+ */
+void Timer1_PC_PWM_SetCompare(t1_pwm_channel_t channel, uint16_t val);
+
+/**
+ * @brief Carga periodo y duties para aplicarlos juntos en el próximo BOTTOM.
+ * @details Los tres valores se escriben desde @ref Timer1_PC_PWM_IRQHandler. En el
+ * Modo 8 la ISR corre en TOP (ICF1): ICR1 no tiene doble buffer pero el contador está
+ * bajando, y los OCR1x se cargan en el mismo BOTTOM en que rige el nuevo TOP.
+ * En el Modo 10 la ISR corre en BOTTOM (TOV1): el nuevo TOP rige de inmediato y los
+ * OCR1x en el TOP siguiente (un semiciclo de transición).
+ * @param top Nuevo ICR1.
+ * @param ocr_a Nuevo OCR1A (0 a top).
+ * @param ocr_b Nuevo OCR1B (0 a top).
+ * @note Habilita ICIE1 (Modo 8) o TOIE1 (Modo 10).
+ */
+void Timer1_PC_PWM_Update(uint16_t top, uint16_t ocr_a, uint16_t ocr_b);
+
+/**
+ * @brief Aplica el periodo/duty pendiente.
+ * @details Debe llamarse desde ISR(TIMER1_CAPT_vect) en el Modo 8 y desde
+ * ISR(TIMER1_OVF_vect) en el Modo 10 (incluido el modo complementario).
+ */
+void Timer1_PC_PWM_IRQHandler(void);
+
+/* --- API del Modo Complementario (Medio Puente) --- */
+
+/**
+ * @brief Configura el Timer 1 en Phase Correct PWM (Modo 10) con salidas complementarias.
+ * @details Las salidas quedan desconectadas (ambos pines en LOW) hasta llamar a
+ * @ref Timer1_PC_PWM_Enable; el duty inicial es 0 (lado bajo conduciendo).
+ * @param prescaler Fuente de reloj (@ref t1_pwm_prescaler_t).
+ * @param top Valor de ICR1 (define la frecuencia).
+ * @param dead_ticks Tiempo muerto en ticks del Timer (se aplica en cada conmutación).
+ */
+void Timer1_PC_PWM_Init(t1_pwm_prescaler_t prescaler, uint16_t top, uint16_t dead_ticks);
+
+/**
+ * @brief Conecta OC1A (Non-Inverting) y OC1B (Inverting) a los pines PB1 y PB2.
+ */
+void Timer1_PC_PWM_Enable(void);
+
+/**
+ * @brief Desconecta ambas salidas y las fuerza a LOW (puente abierto, estado seguro).
+ */
+void Timer1_PC_PWM_Disable(void);
+
+/**
+ * @brief Carga un nuevo duty para aplicar en el próximo BOTTOM.
+ * @details Solo calcula y guarda el par OCR1A/OCR1B; la escritura la hace
+ * @ref Timer1_PC_PWM_IRQHandler para que ambos registros cambien en el mismo periodo.
+ * @param duty Ancho del lado alto en ticks (0 a TOP). Se satura para respetar el tiempo muerto.
+ * @note Habilita la interrupción de Overflow del Timer 1.
+ */
+void Timer1_PC_PWM_SetDuty(uint16_t duty);
+
+/**
+ * @brief Escribe el duty de inmediato. Solo válida dentro de ISR(TIMER1_OVF_vect).
+ * @details En BOTTOM falta medio periodo para que el doble buffer se cargue en TOP, por
+ * lo que el par se escribe sin riesgo de quedar repartido entre dos periodos. Es la
+ * forma indicada para lazos de control que corren a la frecuencia del PWM.
+ * @param duty Ancho del lado alto en ticks (0 a TOP).
+ */
+void Timer1_PC_PWM_Write(uint16_t duty);
+
+#endif /* TIMER1_PC_PWM_H_ */
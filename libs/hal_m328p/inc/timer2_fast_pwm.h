@@ -15,6 +15,8 @@
 
 #include <avr/io.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "pwm_fade.h"
 
 /**
  * @enum t2_pwm_prescaler_t
@@ -100,4 +102,35 @@ void Timer2_PWM_IT_Overflow(uint8_t state);
  */
 void Timer2_PWM_IT_CompareMatch(t2_pwm_channel_t channel, uint8_t state);
 
+/* --- API de Fundidos (ISR de Overflow) --- */
+
+/**
+ * @brief Inicia un fundido del canal desde su duty actual hasta 'target'.
+ * @details El OCR se actualiza en cada Overflow desde @ref Timer2_PWM_Fade_IRQHandler; por el
+ * doble buffer del Fast PWM el valor nuevo rige desde el siguiente periodo completo.
+ * Habilita la interrupción de Overflow del Timer.
+ * @param channel Canal A o B.
+ * @param target Duty final (0-255).
+ * @param duration_ms Duración del fundido en milisegundos.
+ * @param curve Lineal o exponencial (@ref pwm_fade_curve_t).
+ * @param bounce true: ida y vuelta indefinida entre el duty actual y 'target'.
+ */
+void Timer2_PWM_Fade(t2_pwm_channel_t channel, uint8_t target, uint16_t duration_ms,
+                     pwm_fade_curve_t curve, bool bounce);
+
+/**
+ * @brief Indica si el canal tiene un fundido en curso.
+ */
+bool Timer2_PWM_Fade_IsActive(t2_pwm_channel_t channel);
+
+/**
+ * @brief Detiene el fundido del canal dejando el duty en su valor actual.
+ */
+void Timer2_PWM_Fade_Stop(t2_pwm_channel_t channel);
+
+/**
+ * @brief Avanza los fundidos un periodo. Debe llamarse desde ISR(TIMER2_OVF_vect).
+ */
+void Timer2_PWM_Fade_IRQHandler(void);
+
 #endif /* TIMER2_FAST_PWM_H_ */
\ No newline at end of file
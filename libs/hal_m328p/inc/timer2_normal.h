@@ -69,11 +69,29 @@ void Timer2_Normal_Init(t2_prescaler_t prescaler, t2_comp_mode_t mode_a, t2_comp
 /**
  * @brief Activa el funcionamiento asíncrono del Timer 2.
  * @details Configura el registro ASSR para que el Timer sea clockeado por un 
- * cristal externo de 32.768 kHz conectado a TOSC1 y TOSC2. 
- * @note Debe invocarse antes de la inicialización si se desea precisión de reloj.
+ * cristal externo de 32.768 kHz conectado a TOSC1 y TOSC2. Sigue la secuencia del
+ * datasheet: deshabilita las interrupciones del Timer 2 antes de conmutar AS2, ya que
+ * el cambio de reloj puede corromper TCNT2, OCR2x y TCCR2x.
+ * @note Debe invocarse antes de @ref Timer2_Normal_Init. Luego de escribir los registros,
+ * @ref Timer2_Async_Sync espera a que se transfieran al dominio asíncrono.
  */
 void Timer2_Enable_Async(void);
 
+/**
+ * @brief Espera a que los registros escritos se sincronicen con el reloj asíncrono.
+ * @details Bloquea mientras alguno de los flags TCN2UB, OCR2AUB, OCR2BUB, TCR2AUB o
+ * TCR2BUB de ASSR esté activo (hasta 2 ciclos de TOSC1, ~61us con 32.768 kHz).
+ * @note Obligatorio antes de volver a Power-save: si el dispositivo duerme con una
+ * actualización pendiente, el Timer puede no despertarlo.
+ */
+void Timer2_Async_Sync(void);
+
+/**
+ * @brief Limpia los flags de interrupción pendientes (TOV2, OCF2A, OCF2B).
+ * @note Tras conmutar a modo asíncrono los flags pueden quedar en un estado indefinido.
+ */
+static inline void Timer2_Clear_Flags(void) { TIFR2 = (1 << TOV2) | (1 << OCF2A) | (1 << OCF2B); }
+
 /** * @brief Escribe un valor en el contador de hardware (TCNT2).
  * @param val Valor de 8 bits.
  */
@@ -0,0 +1,62 @@
+/**
+ * @file timer_sync.h
+ * @brief Arranque sincronizado y alineación de fase de los Timers 0, 1 y 2 (registro GTCCR).
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details Inicializar los Timers uno tras otro deja una relación de fase aleatoria entre
+ * ellos: los flancos de subida de todos los canales PWM pueden coincidir y sumar sus picos
+ * de corriente. Con el bit TSM de GTCCR los prescalers quedan retenidos en reset
+ * (PSRSYNC para Timer 0/1, PSRASY para Timer 2) mientras se precargan los contadores con
+ * desfasajes elegidos; al limpiar TSM todos arrancan en el mismo ciclo de reloj.
+ * * @note Solo se detienen los Timers con prescaler (N >= 8): con clk/1 el contador recibe
+ * el reloj de E/S directamente y sigue contando. El Timer 2 debe operar en modo síncrono.
+ */
+
+#ifndef TIMER_SYNC_H_
+#define TIMER_SYNC_H_
+
+#include <avr/io.h>
+#include <stdint.h>
+
+/** * @name Selección de Timers
+ * @{
+ */
+#define TIMER_SYNC_T0   (1 << 0)  /**< Precargar TCNT0. */
+#define TIMER_SYNC_T1   (1 << 1)  /**< Precargar TCNT1. */
+#define TIMER_SYNC_T2   (1 << 2)  /**< Precargar TCNT2. */
+/** @} */
+
+/* --- API Pública --- */
+
+/**
+ * @brief Detiene los prescalers de los tres Timers (TSM = 1 con PSRSYNC y PSRASY).
+ * @details Entre esta llamada y @ref Timer_Sync_Release pueden configurarse los Timers y
+ * escribirse sus contadores: ninguno avanza hasta la liberación.
+ */
+static inline void Timer_Sync_Halt(void) {
+    GTCCR = (1 << TSM) | (1 << PSRASY) | (1 << PSRSYNC);
+}
+
+/**
+ * @brief Libera los prescalers a la vez (TSM = 0): todos los Timers arrancan en el mismo ciclo.
+ */
+static inline void Timer_Sync_Release(void) {
+    GTCCR = 0;
+}
+
+/**
+ * @brief Realinea Timers ya configurados con los desfasajes pedidos.
+ * @details Con interrupciones bloqueadas: detiene los prescalers, precarga los contadores
+ * seleccionados en 'mask' y libera todo en una única escritura de GTCCR.
+ * Ejemplo: dos Fast PWM de 8 bits con el mismo prescaler y fases 0 y 128 tienen sus
+ * flancos de subida separados medio periodo.
+ * @param mask Combinación de @ref TIMER_SYNC_T0, @ref TIMER_SYNC_T1, @ref TIMER_SYNC_T2.
+ * Los Timers no seleccionados (ej. el del Systick) conservan su cuenta.
+ * @param t0_phase Valor inicial de TCNT0.
+ * @param t1_phase Valor inicial de TCNT1.
+ * @param t2_phase Valor inicial de TCNT2.
+ */
+void Timer_Sync_Start(uint8_t mask, uint8_t t0_phase, uint16_t t1_phase, uint8_t t2_phase);
+
+#endif /* TIMER_SYNC_H_ */
@@ -0,0 +1,153 @@
+/**
+ * @file osccal.c
+ * @brief Implementación de la auto-calibración del RC interno contra el Timer 2 asíncrono.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. Ventana de referencia: 128 cuentas del Timer 2 a 32.768 kHz (o su equivalente con
+ * el prescaler del RTC) = 1/256 s, independiente del reloj del CPU.
+ * 2. Cronómetro: Timer 1 en Modo Normal con clk/1. A 8 MHz se esperan 31250 ciclos;
+ * incluso con +10% (34375) no desborda los 16 bits.
+ * 3. OSCCAL se recorre de a un paso por escritura: el datasheet advierte que los saltos
+ * grandes pueden hacer fallar al CPU mientras el oscilador se reacomoda.
+ */
+
+#include <avr/interrupt.h>
+#include "osccal.h"
+#include "timer2_normal.h"
+
+/**
+ * @brief Cuentas del Timer 2 por ventana según su prescaler (CS22:20).
+ * @note 0 = prescaler no admitido (ventana mayor a 1/256 s).
+ */
+static const uint8_t WINDOW_TICKS[8] = { 0, 128, 16, 4, 2, 1, 0, 0 };
+
+/**
+ * @brief Lleva OSCCAL al valor pedido de a un paso por vez.
+ * @details Se conserva el bit 7 (selección de rango); el rango no se cambia en caliente.
+ */
+static void Osccal_Walk(uint8_t target) {
+    uint8_t value = OSCCAL;
+    target = (value & 0x80) | (target & 0x7F);
+
+    while (value != target) {
+        value = (value < target) ? (value + 1) : (value - 1);
+        OSCCAL = value;
+        __asm__ __volatile__ ("nop");
+    }
+}
+
+void Osccal_Init(void) {
+    if ((ASSR & (1 << AS2)) && (TCCR2B & 0x07)) return;   /* Ya en marcha (ej. RTC) */
+
+    Timer2_Enable_Async();
+    Timer2_Write_Counter(0);
+    Timer2_Normal_Init(T2_CLK_1, T2_PIN_DISCONNECT, T2_PIN_DISCONNECT);
+    Timer2_Clear_Flags();
+}
+
+/**
+ * @brief Mide los ciclos de CPU en 1/256 s del cristal.
+ * @details Inicio y fin se detectan con el mismo bucle de sondeo sobre TCNT2, por lo que
+ * su latencia se cancela. TCNT2 se lee ya sincronizado por el hardware del modo asíncrono.
+ */
+uint16_t Osccal_Measure(void) {
+    uint8_t window = WINDOW_TICKS[TCCR2B & 0x07];
+    if (window == 0) return 0;
+
+    uint8_t sreg = SREG;
+    cli();
+
+    /* Respaldo del Timer 1 */
+    uint8_t  tccr1a = TCCR1A;
+    uint8_t  tccr1b = TCCR1B;
+    uint16_t tcnt1  = TCNT1;
+
+    TCCR1B = 0;
+    TCCR1A = 0;
+    TCNT1  = 0;
+
+    /* Alineación con un flanco del Timer 2 */
+    uint8_t t0 = TCNT2;
+    while (TCNT2 == t0);
+    TCCR1B = (1 << CS10);
+
+    uint8_t end = (uint8_t)(t0 + 1 + window);
+    while (TCNT2 != end);
+    TCCR1B = 0;
+
+    uint16_t cycles = TCNT1;
+
+    /* Restauración del Timer 1 (se pierde el tiempo de la medición) */
+    TCNT1  = tcnt1;
+    TCCR1A = tccr1a;
+    TCCR1B = tccr1b;
+    TIFR1  = (1 << TOV1);
+
+    SREG = sreg;
+    return cycles;
+}
+
+/**
+ * @brief Devuelve |medido - esperado|.
+ */
+static uint16_t Osccal_Error(uint16_t cycles) {
+    return (cycles > OSCCAL_TARGET_CYCLES) ? (cycles - OSCCAL_TARGET_CYCLES)
+                                           : (OSCCAL_TARGET_CYCLES - cycles);
+}
+
+/**
+ * @brief Búsqueda binaria sobre los 7 bits bajos de OSCCAL y refinamiento final.
+ * @details La frecuencia crece monótonamente con OSCCAL dentro de un mismo rango:
+ * 7 mediciones ubican el primer valor con frecuencia >= objetivo; luego se compara
+ * con su vecino inferior y se queda el de menor error.
+ */
+bool Osccal_Calibrate(void) {
+    if (WINDOW_TICKS[TCCR2B & 0x07] == 0) return false;
+
+    uint8_t lo = 0;
+    uint8_t hi = 127;
+
+    while (lo < hi) {
+        uint8_t mid = (lo + hi) >> 1;
+        Osccal_Walk(mid);
+        if (Osccal_Measure() < OSCCAL_TARGET_CYCLES) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    Osccal_Walk(lo);
+    uint16_t err = Osccal_Error(Osccal_Measure());
+
+    if (lo > 0) {
+        Osccal_Walk(lo - 1);
+        uint16_t err_below = Osccal_Error(Osccal_Measure());
+        if (err_below < err) {
+            err = err_below;
+        } else {
+            Osccal_Walk(lo);
+        }
+    }
+
+    return err <= OSCCAL_TOLERANCE;
+}
+
+/**
+ * @brief Corrige un paso de OSCCAL si el error supera la mitad de la tolerancia.
+ */
+int16_t Osccal_Retrim(void) {
+    if (WINDOW_TICKS[TCCR2B & 0x07] == 0) return 0;
+
+    int16_t diff = (int16_t)(Osccal_Measure() - OSCCAL_TARGET_CYCLES);
+    uint8_t value = OSCCAL & 0x7F;
+
+    if (diff > (int16_t)(OSCCAL_TOLERANCE / 2) && value > 0) {
+        Osccal_Walk(value - 1);
+    } else if (diff < -(int16_t)(OSCCAL_TOLERANCE / 2) && value < 127) {
+        Osccal_Walk(value + 1);
+    }
+    return diff;
+}
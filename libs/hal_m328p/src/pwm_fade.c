@@ -0,0 +1,91 @@
+/**
+ * @file pwm_fade.c
+ * @brief Implementación del núcleo de fundidos compartido por los drivers de PWM.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. Progreso: acumulador de 32 bits; los 16 bits altos son la fracción recorrida (p).
+ * 2. Curva exponencial: 65 puntos de 2^(8x) normalizados en FLASH, interpolados
+ * linealmente con los 10 bits bajos de p (un solo producto de 16x16 bits).
+ * 3. Simetría: un fundido descendente recorre la curva al revés, de modo que bajar
+ * se percibe igual que subir.
+ */
+
+#include <avr/pgmspace.h>
+#include "pwm_fade.h"
+
+/** @brief Curva exponencial (rango dinámico 256:1) muestreada en 65 puntos, Q16. */
+static const uint16_t FADE_EXP_TABLE[65] PROGMEM = {
+        0,    23,    49,    76,   106,   139,   175,   214,
+      257,   304,   354,   410,   470,   536,   607,   686,
+      771,   864,   966,  1076,  1197,  1328,  1472,  1628,
+     1799,  1985,  2188,  2409,  2651,  2914,  3201,  3514,
+     3855,  4227,  4633,  5076,  5558,  6085,  6659,  7284,
+     7967,  8711,  9523, 10408, 11373, 12426, 13574, 14826,
+    16191, 17680, 19303, 21073, 23004, 25109, 27405, 29909,
+    32639, 35616, 38863, 42404, 46265, 50476, 55067, 60075,
+    65535
+};
+
+/**
+ * @brief Evalúa la curva exponencial en p (Q16) con interpolación lineal.
+ */
+static uint16_t Fade_Exp(uint16_t p) {
+    uint8_t  idx  = p >> 10;
+    uint16_t frac = p & 0x3FF;
+    uint16_t a = pgm_read_word(&FADE_EXP_TABLE[idx]);
+    uint16_t b = pgm_read_word(&FADE_EXP_TABLE[idx + 1]);
+    return a + (uint16_t)(((uint32_t)(b - a) * frac) >> 10);
+}
+
+/**
+ * @brief Aplica la curva a la fracción recorrida.
+ */
+static uint16_t Fade_Shape(uint8_t curve, uint16_t p) {
+    return (curve == PWM_FADE_EXP) ? Fade_Exp(p) : p;
+}
+
+void PWM_Fade_Start(PWM_Fade_t* fade, uint16_t from, uint16_t to, uint32_t periods,
+                    pwm_fade_curve_t curve, bool bounce) {
+    if (periods == 0) periods = 1;
+
+    fade->from   = from;
+    fade->to     = to;
+    fade->acc    = 0;
+    fade->inc    = 0xFFFFFFFFUL / periods;
+    fade->curve  = curve;
+    fade->bounce = bounce;
+    fade->active = true;
+}
+
+bool PWM_Fade_Step(PWM_Fade_t* fade, uint16_t* out) {
+    if (!fade->active) return false;
+
+    uint32_t next = fade->acc + fade->inc;
+
+    /* Desborde del acumulador: fin del tramo */
+    if (next < fade->acc) {
+        *out = fade->to;
+        if (fade->bounce) {
+            fade->to   = fade->from;
+            fade->from = *out;
+            fade->acc  = 0;
+        } else {
+            fade->active = false;
+        }
+        return true;
+    }
+    fade->acc = next;
+
+    uint16_t p = (uint16_t)(next >> 16);
+
+    if (fade->to >= fade->from) {
+        uint16_t span = fade->to - fade->from;
+        *out = fade->from + (uint16_t)(((uint32_t)span * Fade_Shape(fade->curve, p)) >> 16);
+    } else {
+        uint16_t span = fade->from - fade->to;
+        *out = fade->to + (uint16_t)(((uint32_t)span * Fade_Shape(fade->curve, 0xFFFF - p)) >> 16);
+    }
+    return true;
+}
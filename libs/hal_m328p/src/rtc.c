@@ -0,0 +1,144 @@
+/**
+ * @file rtc.c
+ * @brief Implementación del RTC sobre el Timer 2 asíncrono.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. Base de tiempo: Overflow del Timer 2 a 1 Hz (cristal 32.768 kHz, prescaler 128).
+ * 2. Calendario: segundos, minutos, horas, días, meses y años bisiestos (tabla en FLASH).
+ * 3. Bajo consumo: modo Power-save con sincronización previa de los registros asíncronos.
+ */
+
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#include "rtc.h"
+#include "timer2_normal.h"
+
+/** @brief Días de cada mes (año no bisiesto), en FLASH. */
+static const uint8_t DAYS_IN_MONTH[12] PROGMEM = {
+    31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+};
+
+/** @brief Calendario actual (modificado en contexto de ISR). */
+static volatile RTC_Time_t rtc_now = { 0, 0, 0, 1, 1, 2026 };
+
+/** @brief Segundos acumulados desde la inicialización. */
+static volatile uint32_t rtc_seconds = 0;
+
+/** @brief Aviso de tick para el loop principal. */
+static volatile bool rtc_tick = false;
+
+/**
+ * @brief Conmuta el Timer 2 al cristal y arma el Overflow de 1 Hz.
+ */
+void RTC_Init(void) {
+    /* 1-2. Interrupciones del Timer 2 deshabilitadas y selección de reloj asíncrono */
+    Timer2_Enable_Async();
+
+    /* 3-4. Registros del Timer (TCNT2 y TCCR2x) y espera de sincronización */
+    Timer2_Write_Counter(0);
+    Timer2_Normal_Init(T2_CLK_128, T2_PIN_DISCONNECT, T2_PIN_DISCONNECT);
+
+    /* 5. Flags en estado conocido y habilitación del tick */
+    Timer2_Clear_Flags();
+    Timer2_Enable_OVF_INT();
+}
+
+/**
+ * @brief Devuelve la cantidad de días del mes, contemplando años bisiestos.
+ * @note Las divisiones por 100 y 400 solo se ejecutan al cerrar febrero.
+ */
+static uint8_t RTC_DaysInMonth(uint8_t month, uint16_t year) {
+    uint8_t days = pgm_read_byte(&DAYS_IN_MONTH[month - 1]);
+    if (month == 2 && (year & 3) == 0 && ((year % 100) != 0 || (year % 400) == 0)) {
+        days = 29;
+    }
+    return days;
+}
+
+/**
+ * @brief Avanza el calendario un segundo.
+ * @details El caso común (segundo < 59) termina tras una comparación.
+ */
+void RTC_IRQHandler(void) {
+    rtc_seconds++;
+    rtc_tick = true;
+
+    if (++rtc_now.second < 60) return;
+    rtc_now.second = 0;
+    if (++rtc_now.minute < 60) return;
+    rtc_now.minute = 0;
+    if (++rtc_now.hour < 24) return;
+    rtc_now.hour = 0;
+    if (++rtc_now.day <= RTC_DaysInMonth(rtc_now.month, rtc_now.year)) return;
+    rtc_now.day = 1;
+    if (++rtc_now.month <= 12) return;
+    rtc_now.month = 1;
+    rtc_now.year++;
+}
+
+void RTC_SetTime(const RTC_Time_t* time) {
+    uint8_t sreg = SREG;
+    cli();
+    rtc_now = *time;
+    SREG = sreg;
+}
+
+void RTC_GetTime(RTC_Time_t* time) {
+    uint8_t sreg = SREG;
+    cli();
+    *time = rtc_now;
+    SREG = sreg;
+}
+
+uint32_t RTC_GetSeconds(void) {
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t s = rtc_seconds;
+    SREG = sreg;
+    return s;
+}
+
+bool RTC_TickPending(void) {
+    uint8_t sreg = SREG;
+    cli();
+    bool pending = rtc_tick;
+    rtc_tick = false;
+    SREG = sreg;
+    return pending;
+}
+
+/**
+ * @brief Duerme en Power-save hasta el próximo tick.
+ * @details
+ * 1. Tras despertar por el Timer 2, el datasheet exige que transcurra al menos un
+ * ciclo de TOSC1 antes de volver a dormir; escribir TCCR2B con su mismo valor y
+ * esperar TCR2BUB = 0 garantiza esa condición y completa cualquier escritura pendiente.
+ * 2. ADC apagado durante el sueño (es el mayor consumidor restante en Power-save).
+ * 3. BOD deshabilitado por software justo antes de SLEEP (bits BODS/BODSE).
+ */
+void RTC_Sleep(void) {
+    uint8_t adcsra = ADCSRA;
+
+    TCCR2B = TCCR2B;
+    Timer2_Async_Sync();
+
+    ADCSRA &= ~(1 << ADEN);
+    set_sleep_mode(SLEEP_MODE_PWR_SAVE);
+
+    cli();
+    if (!rtc_tick) {
+        sleep_enable();
+#if defined(BODS) && defined(BODSE)
+        sleep_bod_disable();
+#endif
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+
+    ADCSRA = adcsra;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file soft_pwm.c
+ * @brief Implementación del PWM por software con Bit-Angle Modulation (BAM).
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. Cuadro: para cada ranura (bit 0..7) se precalcula un byte por puerto con los pines
+ * que deben estar en HIGH. La ISR solo copia tres bytes y reprograma OCR1A.
+ * 2. Temporización: Timer 1 en Modo CTC; la ranura del bit b dura UNIT << b ticks.
+ * Como cada ISR se atiende con la misma latencia tras su Match, los anchos se conservan.
+ * 3. Doble buffer: @ref SoftPWM_Commit llena el cuadro inactivo y la ISR lo intercambia
+ * al comenzar la ranura 0, por lo que un cambio nunca se ve a mitad de periodo.
+ */
+
+#include <avr/interrupt.h>
+#include "soft_pwm.h"
+
+/** @brief Índices de puerto dentro de un cuadro (BAM_PORT_NONE: registro no soportado). */
+enum { BAM_PORT_B = 0, BAM_PORT_C = 1, BAM_PORT_D = 2, BAM_PORTS = 3, BAM_PORT_NONE = 0xFF };
+
+/** @brief Bytes de puerto por ranura, doble buffer. */
+static uint8_t bam_frame[2][SOFT_PWM_BITS][BAM_PORTS];
+
+/** @brief Máscara de pines NO controlados por el motor (se preservan en cada escritura). */
+static uint8_t bam_keep[BAM_PORTS] = { 0xFF, 0xFF, 0xFF };
+
+/** @brief Puerto y máscara de cada canal. */
+static uint8_t bam_ch_port[SOFT_PWM_MAX_CHANNELS];
+static uint8_t bam_ch_mask[SOFT_PWM_MAX_CHANNELS];
+
+/** @brief Duty de trabajo de cada canal (aún no publicado). */
+static uint8_t bam_duty[SOFT_PWM_MAX_CHANNELS];
+
+static uint8_t          bam_count   = 0;
+static volatile uint8_t bam_active  = 0;     /**< Cuadro que recorre la ISR. */
+static volatile bool    bam_pending = false; /**< Hay un cuadro nuevo esperando la ranura 0. */
+static uint8_t          bam_slot    = SOFT_PWM_BITS - 1;
+
+/**
+ * @brief Traduce un registro PORTx a su índice dentro del cuadro.
+ * @return BAM_PORT_NONE si no es PORTB, PORTC ni PORTD (incluido NULL).
+ */
+static uint8_t SoftPWM_Port_Index(volatile uint8_t* port) {
+    if (port == &PORTB) return BAM_PORT_B;
+    if (port == &PORTC) return BAM_PORT_C;
+    if (port == &PORTD) return BAM_PORT_D;
+    return BAM_PORT_NONE;
+}
+
+void SoftPWM_Init(const SoftPWM_Pin_t* pins, uint8_t count) {
+    if (count > SOFT_PWM_MAX_CHANNELS) count = SOFT_PWM_MAX_CHANNELS;
+
+    /* Timer detenido mientras se arman las tablas */
+    TCCR1B = 0;
+
+    bam_count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t port = SoftPWM_Port_Index(pins[i].port);
+        bam_duty[i]  = 0;
+
+        /* Canal rechazado: conserva su número pero sin pin (máscara vacía, no toca puertos) */
+        if (port == BAM_PORT_NONE || pins[i].pin > 7) {
+            bam_ch_port[i] = BAM_PORT_B;
+            bam_ch_mask[i] = 0;
+            continue;
+        }
+
+        uint8_t mask = (1 << pins[i].pin);
+        bam_ch_port[i] = port;
+        bam_ch_mask[i] = mask;
+
+        bam_keep[bam_ch_port[i]] &= ~mask;
+        *(pins[i].port)     &= ~mask;          /* Arranque en LOW */
+        *(pins[i].port - 1) |= mask;           /* DDRx = PORTx - 1 */
+    }
+
+    for (uint8_t s = 0; s < SOFT_PWM_BITS; s++) {
+        for (uint8_t p = 0; p < BAM_PORTS; p++) {
+            bam_frame[0][s][p] = 0;
+            bam_frame[1][s][p] = 0;
+        }
+    }
+    bam_active  = 0;
+    bam_pending = false;
+    bam_slot    = SOFT_PWM_BITS - 1;   /* La primera ISR abre la ranura 0 */
+
+    Timer1_CTC_Init(T1_CLK_8, T1_PIN_DISCONNECT, T1_PIN_DISCONNECT, SOFT_PWM_UNIT_TICKS - 1);
+    Timer1_Enable_COMPA_INT();
+}
+
+void SoftPWM_SetDuty(uint8_t channel, uint8_t duty) {
+    if (channel < bam_count) bam_duty[channel] = duty;
+}
+
+uint8_t SoftPWM_GetDuty(uint8_t channel) {
+    return (channel < bam_count) ? bam_duty[channel] : 0;
+}
+
+/**
+ * @brief Construye el cuadro inactivo y lo marca para intercambio.
+ * @details El costo (canales x 8) recae en el loop principal, nunca en la ISR.
+ */
+void SoftPWM_Commit(void) {
+    /* El cuadro inactivo sigue reservado hasta que la ISR tome el anterior */
+    while (bam_pending);
+
+    uint8_t (*frame)[BAM_PORTS] = bam_frame[bam_active ^ 1];
+
+    for (uint8_t s = 0; s < SOFT_PWM_BITS; s++) {
+        frame[s][BAM_PORT_B] = 0;
+        frame[s][BAM_PORT_C] = 0;
+        frame[s][BAM_PORT_D] = 0;
+    }
+
+    for (uint8_t i = 0; i < bam_count; i++) {
+        uint8_t duty = bam_duty[i];
+        uint8_t port = bam_ch_port[i];
+        uint8_t mask = bam_ch_mask[i];
+
+        for (uint8_t s = 0; s < SOFT_PWM_BITS; s++) {
+            if (duty & 1) frame[s][port] |= mask;
+            duty >>= 1;
+        }
+    }
+
+    bam_pending = true;
+}
+
+/**
+ * @brief Abre la siguiente ranura: bytes de puerto y duración.
+ * @note La escritura de PORTx es lectura-modificación-escritura: el loop principal debe
+ * modificar los otros pines de esos puertos con instrucciones atómicas (SBI/CBI, es
+ * decir, pines constantes) o dentro de una sección crítica.
+ */
+void SoftPWM_IRQHandler(void) {
+    uint8_t slot = (bam_slot + 1) & (SOFT_PWM_BITS - 1);
+
+    if (slot == 0 && bam_pending) {
+        bam_active ^= 1;
+        bam_pending = false;
+    }
+
+    const uint8_t* f = bam_frame[bam_active][slot];
+    PORTB = (PORTB & bam_keep[BAM_PORT_B]) | f[BAM_PORT_B];
+    PORTC = (PORTC & bam_keep[BAM_PORT_C]) | f[BAM_PORT_C];
+    PORTD = (PORTD & bam_keep[BAM_PORT_D]) | f[BAM_PORT_D];
+
+    /* El contador ya volvió a 0: el nuevo TOP rige para esta ranura */
+    Timer1_Reload_AlarmA(((uint16_t)SOFT_PWM_UNIT_TICKS << slot) - 1);
+    bam_slot = slot;
+}
@@ -10,6 +10,16 @@
 
 #include "timer0_fast_pwm.h"
 #include "gpio.h"
+#include <avr/interrupt.h>
+
+/** @brief Divisor de cada fuente de reloj (0 = externa o detenido). */
+static const uint16_t T0_DIVIDERS[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+/** @brief Frecuencia de Overflow calculada en la inicialización (periodos por segundo). */
+static uint32_t t0_ovf_hz = 0;
+
+/** @brief Estado de fundido de los canales A y B. */
+static PWM_Fade_t t0_fade[2];
 
 /**
  * @brief Inicializa el hardware del Timer 0 para Fast PWM.
@@ -37,6 +47,12 @@ void Timer0_PWM_Init(t0_pwm_prescaler_t prescaler) {
      * Aplicamos una máscara (0x07) para asegurar que solo modificamos los 3 bits
      * de prescaler sin alterar el resto de la configuración. */
     TCCR0B = (TCCR0B & ~0x07) | (prescaler & 0x07);
+
+    /* Base de tiempo de los fundidos: F_ovf = F_CPU / (N * (TOP + 1)) */
+    uint16_t div = T0_DIVIDERS[prescaler & 0x07];
+    t0_ovf_hz = div ? (F_CPU / div) / 256UL : 0;
+    t0_fade[0].active = false;
+    t0_fade[1].active = false;
 }
 
 /**
@@ -119,4 +135,44 @@ void Timer0_PWM_IT_CompareMatch(t0_pwm_channel_t channel, uint8_t state) {
         if (state) TIMSK0 |= (1 << OCIE0B);
         else TIMSK0 &= ~(1 << OCIE0B);
     }
-}
\ No newline at end of file
+}
+
+/* --- Fundidos (ISR de Overflow) --- */
+
+/**
+ * @brief Inicia un fundido tomando como origen el valor actual del OCR.
+ * @details El estado se carga con interrupciones bloqueadas para que la ISR nunca
+ * observe un fundido a medio configurar. Con reloj externo (frecuencia desconocida)
+ * el cambio se aplica en el siguiente Overflow.
+ */
+void Timer0_PWM_Fade(t0_pwm_channel_t channel, uint8_t target, uint16_t duration_ms,
+                     pwm_fade_curve_t curve, bool bounce) {
+    uint8_t sreg = SREG;
+    cli();
+
+    uint16_t now = (channel == T0_PWM_CH_A) ? OCR0A : OCR0B;
+    PWM_Fade_Start(&t0_fade[channel], now, target,
+                   PWM_Fade_Periods(duration_ms, t0_ovf_hz), curve, bounce);
+    TIMSK0 |= (1 << TOIE0);
+
+    SREG = sreg;
+}
+
+bool Timer0_PWM_Fade_IsActive(t0_pwm_channel_t channel) {
+    return t0_fade[channel].active;
+}
+
+void Timer0_PWM_Fade_Stop(t0_pwm_channel_t channel) {
+    t0_fade[channel].active = false;
+}
+
+/**
+ * @brief Avanza los dos canales un periodo de PWM.
+ * @details Se ejecuta en TOP (Overflow): el valor escrito en OCR0x queda en el buffer y el
+ * hardware lo aplica en BOTTOM, al comenzar el periodo siguiente, sin truncar el pulso.
+ */
+void Timer0_PWM_Fade_IRQHandler(void) {
+    uint16_t val;
+    if (PWM_Fade_Step(&t0_fade[0], &val)) OCR0A = val;
+    if (PWM_Fade_Step(&t0_fade[1], &val)) OCR0B = val;
+}
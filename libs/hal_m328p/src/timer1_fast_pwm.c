@@ -13,6 +13,19 @@
 
 #include "timer1_fast_pwm.h"
 #include "gpio.h"
+#include <avr/interrupt.h>
+
+/** @brief Divisor de cada fuente de reloj (0 = externa o detenido). */
+static const uint16_t T1_DIVIDERS[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+
+/** @brief Frecuencia de Overflow calculada en la inicialización (periodos por segundo). */
+static uint32_t t1_ovf_hz = 0;
+
+/** @brief Estado de fundido de los canales A y B. */
+static PWM_Fade_t t1_fade[2];
+
+/** @brief Dithering Sigma-Delta: parte entera, fracción y acumulador por canal. */
+t1_pwm_dither_t t1_pwm_dither;
 
 /**
  * @brief Inicializa el Timer 1 para operar en modo Fast PWM (Modo 14).
@@ -45,6 +58,12 @@ void Timer1_PWM_Fast_Init(t1_pwm_prescaler_t prescaler, uint16_t top_value) {
      * Se aplica una máscara (0x07) para modificar solo los bits de prescaler.
      * Esto arranca el temporizador con la fuente de reloj elegida. */
     TCCR1B = (TCCR1B & ~0x07) | (prescaler & 0x07);
+
+    /* Base de tiempo de los fundidos: F_ovf = F_CPU / (N * (TOP + 1)) */
+    uint16_t div = T1_DIVIDERS[prescaler & 0x07];
+    t1_ovf_hz = div ? (F_CPU / div) / ((uint32_t)top_value + 1) : 0;
+    t1_fade[0].active = false;
+    t1_fade[1].active = false;
 }
 
 /**
@@ -129,4 +148,75 @@ void Timer1_PWM_IT_CompareMatch(t1_pwm_channel_t channel, uint8_t state) {
         if (state) TIMSK1 |= (1 << OCIE1B);
         else TIMSK1 &= ~(1 << OCIE1B);
     }
-}
\ No newline at end of file
+}
+
+/* --- Fundidos (ISR de Overflow) --- */
+
+/**
+ * @brief Inicia un fundido tomando como origen el valor actual del OCR.
+ * @details El estado se carga con interrupciones bloqueadas para que la ISR nunca
+ * observe un fundido a medio configurar. Con reloj externo (frecuencia desconocida)
+ * el cambio se aplica en el siguiente Overflow.
+ */
+void Timer1_PWM_Fade(t1_pwm_channel_t channel, uint16_t target, uint16_t duration_ms,
+                     pwm_fade_curve_t curve, bool bounce) {
+    uint8_t sreg = SREG;
+    cli();
+
+    uint16_t now = (channel == T1_PWM_CH_A) ? OCR1A : OCR1B;
+    PWM_Fade_Start(&t1_fade[channel], now, target,
+                   PWM_Fade_Periods(duration_ms, t1_ovf_hz), curve, bounce);
+    TIMSK1 |= (1 << TOIE1);
+
+    SREG = sreg;
+}
+
+bool Timer1_PWM_Fade_IsActive(t1_pwm_channel_t channel) {
+    return t1_fade[channel].active;
+}
+
+void Timer1_PWM_Fade_Stop(t1_pwm_channel_t channel) {
+    t1_fade[channel].active = false;
+}
+
+/**
+ * @brief Avanza los dos canales un periodo de PWM.
+ * @details Se ejecuta en TOP (Overflow): el valor escrito en OCR1x queda en el buffer y el
+ * hardware lo aplica en BOTTOM, al comenzar el periodo siguiente, sin truncar el pulso.
+ */
+void Timer1_PWM_Fade_IRQHandler(void) {
+    uint16_t val;
+    if (PWM_Fade_Step(&t1_fade[0], &val)) OCR1A = val;
+    if (PWM_Fade_Step(&t1_fade[1], &val)) OCR1B = val;
+}
+
+/* --- Dithering Sigma-Delta (ISR de Overflow) --- */
+
+/**
+ * @brief Carga parte entera y fracción con interrupciones bloqueadas.
+ * @details El acumulador no se reinicia: un cambio de duty continúa la secuencia sin
+ * introducir un salto de error.
+ */
+void Timer1_PWM_Dither_Set(t1_pwm_channel_t channel, uint32_t duty_q16) {
+    uint8_t sreg = SREG;
+    cli();
+
+    t1_pwm_dither.integer[channel] = (uint16_t)(duty_q16 >> 16);
+    t1_pwm_dither.frac[channel]    = (uint16_t)duty_q16;
+    t1_pwm_dither.mask |= (1 << channel);
+    TIMSK1 |= (1 << TOIE1);
+
+    SREG = sreg;
+}
+
+void Timer1_PWM_Dither_Stop(t1_pwm_channel_t channel) {
+    uint8_t sreg = SREG;
+    cli();
+
+    t1_pwm_dither.mask &= ~(1 << channel);
+    if (channel == T1_PWM_CH_A) OCR1A = t1_pwm_dither.integer[0];
+    else                        OCR1B = t1_pwm_dither.integer[1];
+
+    SREG = sreg;
+}
+
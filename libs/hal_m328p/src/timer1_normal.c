@@ -33,6 +33,30 @@ void Timer1_Normal_Init(t1_prescaler_t prescaler, t1_comp_mode_t mode_a, t1_comp
     TCCR1B = (prescaler & 0x07);
 }
 
+/**
+ * @brief Inicializa el Timer 1 en Modo CTC (Clear Timer on Compare Match).
+ * @details Configura WGM13:10 = 0100 (Modo 4): el TOP es OCR1A y el contador vuelve
+ * a 0 tras cada coincidencia. El periodo se carga antes de aplicar el reloj para que
+ * el primer ciclo ya tenga la duración correcta.
+ * * @param prescaler Divisor de frecuencia (T1_OFF: configurado pero detenido).
+ * @param mode_a Comportamiento físico del pin OC1A (PB1) ante un Match.
+ * @param mode_b Comportamiento físico del pin OC1B (PB2) ante un Match.
+ * @param top Valor de TOP cargado en OCR1A.
+ */
+void Timer1_CTC_Init(t1_prescaler_t prescaler, t1_comp_mode_t mode_a, t1_comp_mode_t mode_b, uint16_t top) {
+    /* Timer detenido mientras se reconfigura */
+    TCCR1B = 0;
+
+    /* WGM11:10 en 0 (TCCR1A) y COM1x1:0 según el modo de pin pedido */
+    TCCR1A = (mode_a << COM1A0) | (mode_b << COM1B0);
+
+    OCR1A = top;
+    TCNT1 = 0;
+
+    /* WGM12 = 1 selecciona CTC con TOP en OCR1A; CS12:10 arrancan el reloj */
+    TCCR1B = (1 << WGM12) | (prescaler & 0x07);
+}
+
 /**
  * @brief Configura la Unidad de Captura de Entrada (Input Capture Unit).
  * @details Permite capturar el valor de TCNT1 en el registro ICR1 ante un evento
@@ -53,26 +77,6 @@ void Timer1_InputCapture_Init(bool rising_edge, bool noise_canceller) {
     TIMSK1 |= (1 << ICIE1);
 }
 
-/**
- * @brief Escribe un valor de 16 bits en el registro contador TCNT1.
- * @note El hardware requiere que el byte ALTO se escriba antes que el bajo. 
- * avr-gcc garantiza este orden al operar sobre el símbolo de 16 bits 'TCNT1'.
- * @param val Valor de 16 bits (0-65535).
- */
-void Timer1_Write_Counter(uint16_t val) {
-    TCNT1 = val;
-}
-
-/**
- * @brief Lee el valor actual del contador de 16 bits.
- * @details El hardware utiliza un registro temporal (TEMP) para asegurar la 
- * coherencia de los dos bytes leídos. 
- * @return uint16_t Valor actual de TCNT1.
- */
-uint16_t Timer1_Read_Counter(void) {
-    return TCNT1;
-}
-
 /**
  * @brief Configura la Alarma A (Canal de comparación A).
  * @details Al producirse el Match (TCNT1 == OCR1A), se dispara la interrupción 
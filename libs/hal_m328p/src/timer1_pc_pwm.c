@@ -0,0 +1,196 @@
+/**
+ * @file timer1_pc_pwm.c
+ * @brief Implementación del PWM centrado del Timer 1 (Modos 8 y 10) y del modo complementario.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. Actualización atómica: periodo y duties se guardan como pendientes y una única ISR
+ * los escribe juntos, en el punto del ciclo en que el doble buffer del modo activo
+ * los hace regir a la vez (ver @ref Timer1_PC_PWM_Update).
+ * 2. Modo complementario: en Phase Correct los OCR1x se cargan desde su buffer en TOP.
+ * Si OCR1A y OCR1B se actualizaran en periodos distintos, un aumento de duty podría
+ * superponer ambos lados; por eso el par se escribe siempre en BOTTOM (ISR de Overflow).
+ * 3. Costo: el cálculo del par es una resta, una suma y dos comparaciones (sin
+ * divisiones), apto para lazos de control de 20kHz.
+ */
+
+#include <avr/interrupt.h>
+#include "timer1_pc_pwm.h"
+#include "gpio.h"
+
+static uint8_t  pc_mode      = T1_PC_PHASE; /**< Modo WGM activo (8 o 10). */
+static uint16_t pc_top       = 0;  /**< ICR1 configurado. */
+static uint16_t pc_dead_lo   = 0;  /**< Mitad del tiempo muerto (antes del duty). */
+static uint16_t pc_dead_hi   = 0;  /**< Resto del tiempo muerto (después del duty). */
+
+static volatile uint16_t pc_next_top = 0;      /**< ICR1 pendiente. */
+static volatile uint16_t pc_next_a   = 0;      /**< OCR1A pendiente. */
+static volatile uint16_t pc_next_b   = 0;      /**< OCR1B pendiente. */
+static volatile bool     pc_pending  = false;  /**< Hay valores por aplicar. */
+
+/**
+ * @brief Habilita la interrupción en la que se aplican los pendientes según el modo.
+ */
+static void PC_PWM_Arm(void) {
+    if (pc_mode == T1_PC_PHASE_FREQ) TIMSK1 |= (1 << ICIE1);  /* TOP */
+    else                             TIMSK1 |= (1 << TOIE1);  /* BOTTOM */
+}
+
+/**
+ * @brief Publica un juego de valores pendientes (atómico respecto de la ISR).
+ */
+static void PC_PWM_Post(uint16_t top, uint16_t a, uint16_t b) {
+    uint8_t sreg = SREG;
+    cli();
+    pc_next_top = top;
+    pc_next_a   = a;
+    pc_next_b   = b;
+    pc_pending  = true;
+    PC_PWM_Arm();
+    SREG = sreg;
+}
+
+/**
+ * @brief Inicializa el Timer 1 en Modo 8 o 10 con TOP en ICR1.
+ * @details
+ * 1. WGM13 = 1 en ambos modos; WGM11 = 1 distingue el Modo 10 del Modo 8.
+ * 2. ICR1 y los OCR1x (en 0) se cargan con el reloj detenido.
+ * 3. COM1x1:0 = 0: los pines se conectan luego con @ref Timer1_PC_PWM_EnableChannel.
+ */
+void Timer1_PC_PWM_Init_Mode(t1_pc_mode_t mode, t1_pwm_prescaler_t prescaler, uint16_t top) {
+    TCCR1B = 0;
+    TCCR1A = (mode == T1_PC_PHASE) ? (1 << WGM11) : 0;
+
+    pc_mode    = mode;
+    pc_top     = top;
+    pc_pending = false;
+
+    ICR1  = top;
+    OCR1A = 0;
+    OCR1B = 0;
+    TCNT1 = 0;
+
+    TCCR1B = (1 << WGM13) | (prescaler & 0x07);
+}
+
+void Timer1_PC_PWM_EnableChannel(t1_pwm_channel_t channel, t1_pwm_mode_t mode) {
+    if (channel == T1_PWM_CH_A) {
+        GPIO_InitPin(GPIO_B, 1, GPIO_OUTPUT);
+        TCCR1A = (TCCR1A & ~((1 << COM1A1) | (1 << COM1A0))) | (mode << COM1A0);
+    } else {
+        GPIO_InitPin(GPIO_B, 2, GPIO_OUTPUT);
+        TCCR1A = (TCCR1A & ~((1 << COM1B1) | (1 << COM1B0))) | (mode << COM1B0);
+    }
+}
+
+void Timer1_PC_PWM_DisableChannel(t1_pwm_channel_t channel) {
+    if (channel == T1_PWM_CH_A) {
+        TCCR1A &= ~((1 << COM1A1) | (1 << COM1A0));
+    } else {
+        TCCR1A &= ~((1 << COM1B1) | (1 << COM1B0));
+    }
+}
+
+void Timer1_PC_PWM_SetCompare(t1_pwm_channel_t channel, uint16_t val) {
+    if (channel == T1_PWM_CH_A) {
+        OCR1A = val;
+    } else {
+        OCR1B = val;
+    }
+}
+
+void Timer1_PC_PWM_Update(uint16_t top, uint16_t ocr_a, uint16_t ocr_b) {
+    if (ocr_a > top) ocr_a = top;
+    if (ocr_b > top) ocr_b = top;
+    PC_PWM_Post(top, ocr_a, ocr_b);
+}
+
+/**
+ * @brief Escribe los pendientes. ICR1 solo se toca si cambió.
+ */
+void Timer1_PC_PWM_IRQHandler(void) {
+    if (!pc_pending) return;
+    if (pc_next_top != pc_top) {
+        ICR1   = pc_next_top;
+        pc_top = pc_next_top;
+    }
+    OCR1A = pc_next_a;
+    OCR1B = pc_next_b;
+    pc_pending = false;
+}
+
+/* --- Modo Complementario --- */
+
+/**
+ * @brief Convierte el duty en el par OCR1A/OCR1B respetando el tiempo muerto.
+ */
+static void PC_PWM_Pair(uint16_t duty, uint16_t* a, uint16_t* b) {
+    if (duty > pc_top) duty = pc_top;
+
+    if (duty < pc_dead_lo) {
+        *a = 0;
+        *b = pc_dead_lo + pc_dead_hi;
+    } else if (duty > pc_top - pc_dead_hi) {
+        *b = pc_top;
+        *a = pc_top - pc_dead_lo - pc_dead_hi;
+    } else {
+        *a = duty - pc_dead_lo;
+        *b = duty + pc_dead_hi;
+    }
+}
+
+/**
+ * @brief Inicializa el Modo 10 con el par de duty 0 y las salidas desconectadas.
+ * @details Los pines se configuran como salida en LOW: hasta @ref Timer1_PC_PWM_Enable
+ * el puente queda abierto.
+ */
+void Timer1_PC_PWM_Init(t1_pwm_prescaler_t prescaler, uint16_t top, uint16_t dead_ticks) {
+    Timer1_PC_PWM_Init_Mode(T1_PC_PHASE, T1_PWM_OFF, top);
+
+    if (dead_ticks > top) dead_ticks = top;
+    pc_dead_lo = dead_ticks >> 1;
+    pc_dead_hi = dead_ticks - pc_dead_lo;
+
+    uint16_t a, b;
+    PC_PWM_Pair(0, &a, &b);
+    OCR1A = a;
+    OCR1B = b;
+
+    GPIO_InitPin(GPIO_B, 1, GPIO_OUTPUT);
+    GPIO_InitPin(GPIO_B, 2, GPIO_OUTPUT);
+    GPIO_WritePin(GPIO_B, 1, GPIO_LOW);
+    GPIO_WritePin(GPIO_B, 2, GPIO_LOW);
+
+    TCCR1B = (TCCR1B & ~0x07) | (prescaler & 0x07);
+}
+
+/**
+ * @brief Conecta las dos salidas en el mismo acceso a TCCR1A.
+ * @details COM1A1:0 = 10 (Non-Inverting) y COM1B1:0 = 11 (Inverting).
+ */
+void Timer1_PC_PWM_Enable(void) {
+    TCCR1A = (TCCR1A & ~((1 << COM1A1) | (1 << COM1A0) | (1 << COM1B1) | (1 << COM1B0)))
+           | (1 << COM1A1) | (1 << COM1B1) | (1 << COM1B0);
+}
+
+/**
+ * @brief Devuelve ambos pines al control del GPIO (PORTB1:2 = 0).
+ */
+void Timer1_PC_PWM_Disable(void) {
+    TCCR1A &= ~((1 << COM1A1) | (1 << COM1A0) | (1 << COM1B1) | (1 << COM1B0));
+    PORTB &= ~((1 << PB1) | (1 << PB2));
+}
+
+void Timer1_PC_PWM_SetDuty(uint16_t duty) {
+    uint16_t a, b;
+    PC_PWM_Pair(duty, &a, &b);
+    PC_PWM_Post(pc_top, a, b);
+}
+
+void Timer1_PC_PWM_Write(uint16_t duty) {
+    uint16_t a, b;
+    PC_PWM_Pair(duty, &a, &b);
+    OCR1A = a;
+    OCR1B = b;
+}
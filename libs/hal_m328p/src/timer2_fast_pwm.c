@@ -11,6 +11,16 @@
 
 #include "timer2_fast_pwm.h"
 #include "gpio.h"
+#include <avr/interrupt.h>
+
+/** @brief Divisor de cada fuente de reloj (0 = externa o detenido). */
+static const uint16_t T2_DIVIDERS[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+
+/** @brief Frecuencia de Overflow calculada en la inicialización (periodos por segundo). */
+static uint32_t t2_ovf_hz = 0;
+
+/** @brief Estado de fundido de los canales A y B. */
+static PWM_Fade_t t2_fade[2];
 
 /**
  * @brief Inicializa el hardware del Timer 2 para Fast PWM.
@@ -39,6 +49,12 @@ void Timer2_PWM_Fast_Init(t2_pwm_prescaler_t prescaler) {
      * Aplicamos máscara 0x07 para proteger el resto del registro y 
      * cargamos el valor del enum para arrancar el temporizador. */
     TCCR2B = (TCCR2B & ~0x07) | (prescaler & 0x07);
+
+    /* Base de tiempo de los fundidos: F_ovf = F_CPU / (N * (TOP + 1)) */
+    uint16_t div = T2_DIVIDERS[prescaler & 0x07];
+    t2_ovf_hz = div ? (F_CPU / div) / 256UL : 0;
+    t2_fade[0].active = false;
+    t2_fade[1].active = false;
 }
 
 /**
@@ -122,4 +138,44 @@ void Timer2_PWM_IT_CompareMatch(t2_pwm_channel_t channel, uint8_t state) {
         if (state) TIMSK2 |= (1 << OCIE2B);
         else TIMSK2 &= ~(1 << OCIE2B);
     }
-}
\ No newline at end of file
+}
+
+/* --- Fundidos (ISR de Overflow) --- */
+
+/**
+ * @brief Inicia un fundido tomando como origen el valor actual del OCR.
+ * @details El estado se carga con interrupciones bloqueadas para que la ISR nunca
+ * observe un fundido a medio configurar. Con reloj externo (frecuencia desconocida)
+ * el cambio se aplica en el siguiente Overflow.
+ */
+void Timer2_PWM_Fade(t2_pwm_channel_t channel, uint8_t target, uint16_t duration_ms,
+                     pwm_fade_curve_t curve, bool bounce) {
+    uint8_t sreg = SREG;
+    cli();
+
+    uint16_t now = (channel == T2_PWM_CH_A) ? OCR2A : OCR2B;
+    PWM_Fade_Start(&t2_fade[channel], now, target,
+                   PWM_Fade_Periods(duration_ms, t2_ovf_hz), curve, bounce);
+    TIMSK2 |= (1 << TOIE2);
+
+    SREG = sreg;
+}
+
+bool Timer2_PWM_Fade_IsActive(t2_pwm_channel_t channel) {
+    return t2_fade[channel].active;
+}
+
+void Timer2_PWM_Fade_Stop(t2_pwm_channel_t channel) {
+    t2_fade[channel].active = false;
+}
+
+/**
+ * @brief Avanza los dos canales un periodo de PWM.
+ * @details Se ejecuta en TOP (Overflow): el valor escrito en OCR2x queda en el buffer y el
+ * hardware lo aplica en BOTTOM, al comenzar el periodo siguiente, sin truncar el pulso.
+ */
+void Timer2_PWM_Fade_IRQHandler(void) {
+    uint16_t val;
+    if (PWM_Fade_Step(&t2_fade[0], &val)) OCR2A = val;
+    if (PWM_Fade_Step(&t2_fade[1], &val)) OCR2B = val;
+}
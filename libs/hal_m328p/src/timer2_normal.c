@@ -29,21 +29,44 @@ void Timer2_Normal_Init(t2_prescaler_t prescaler, t2_comp_mode_t mode_a, t2_comp
     /* 2. Configuración del Prescaler (CS2x):
        WGM22 se mantiene en 0. Se aplica una máscara de seguridad sobre los bits 0:2. */
     TCCR2B = (prescaler & 0x07);
+
+    /* 3. En modo asíncrono las escrituras tardan hasta 2 ciclos de TOSC1 en aplicarse */
+    if (ASSR & (1 << AS2)) {
+        Timer2_Async_Sync();
+    }
 }
 
 /**
  * @brief Habilita el Reloj Asíncrono para el Timer 2.
  * @details Desconecta el Timer 2 del reloj interno de E/S y lo conecta a los 
  * pines TOSC1/2 (cristal de 32.768 kHz). 
- * * @warning Tras llamar a esta función, los registros TCNT2, OCR2A y OCR2B 
- * requieren varios ciclos del reloj externo para estabilizarse. Se debe 
- * monitorear el registro ASSR antes de realizar escrituras consecutivas.
+ * * Secuencia del datasheet ("Asynchronous Operation of Timer/Counter2"):
+ * 1. Deshabilitar OCIE2x y TOIE2.
+ * 2. Seleccionar el reloj asíncrono (AS2).
+ * 3. Escribir TCNT2, OCR2x y TCCR2x (lo hace @ref Timer2_Normal_Init).
+ * 4. Esperar TCN2UB, OCR2xUB y TCR2xUB en 0 (@ref Timer2_Async_Sync).
+ * 5. Limpiar los flags de interrupción y recién entonces habilitar las interrupciones.
+ * * @warning El cristal de 32.768 kHz puede demorar hasta ~1s en estabilizarse tras el
+ * encendido; las primeras interrupciones pueden tener un periodo irregular.
  */
 void Timer2_Enable_Async(void) {
-    /* Habilita el bit AS2 (Asynchronous Timer/Counter2) */
+    /* Paso 1: sin interrupciones del Timer 2 durante el cambio de reloj */
+    TIMSK2 = 0;
+
+    /* Paso 2: habilita el bit AS2 (Asynchronous Timer/Counter2) */
     ASSR |= (1 << AS2);
 }
 
+/**
+ * @brief Espera la sincronización de los registros del Timer 2 asíncrono.
+ * @details Cada escritura a TCNT2, OCR2A/B o TCCR2A/B se copia a un registro temporal
+ * y se transfiere en los siguientes flancos de TOSC1; mientras tanto el flag "Update
+ * Busy" correspondiente permanece en 1.
+ */
+void Timer2_Async_Sync(void) {
+    while (ASSR & ((1 << TCN2UB) | (1 << OCR2AUB) | (1 << OCR2BUB) | (1 << TCR2AUB) | (1 << TCR2BUB)));
+}
+
 /**
  * @brief Configura la Alarma A (Match) y habilita su interrupción.
  * @details Carga el registro OCR2A para disparar eventos determinísticos. 
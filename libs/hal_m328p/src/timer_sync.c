@@ -0,0 +1,31 @@
+/**
+ * @file timer_sync.c
+ * @brief Implementación del arranque sincronizado de Timers mediante GTCCR.
+ * @author Mamani Flores Carlos
+ * @date 2026
+ *
+ * @details
+ * 1. TSM = 1 mantiene activas las señales de reset de los prescalers mientras dure.
+ * 2. Los contadores se precargan con el reloj retenido: la fase relativa queda fija.
+ * 3. Una sola escritura de GTCCR = 0 libera ambos prescalers en el mismo ciclo.
+ */
+
+#include <avr/interrupt.h>
+#include "timer_sync.h"
+
+void Timer_Sync_Start(uint8_t mask, uint8_t t0_phase, uint16_t t1_phase, uint8_t t2_phase) {
+    uint8_t sreg = SREG;
+    cli();
+
+    Timer_Sync_Halt();
+
+    /* Escribir TCNTn bloquea el Compare Match del siguiente tick del Timer: solo
+     * afecta al primer periodo si la fase coincide con el valor de un OCR. */
+    if (mask & TIMER_SYNC_T0) TCNT0 = t0_phase;
+    if (mask & TIMER_SYNC_T1) TCNT1 = t1_phase;
+    if (mask & TIMER_SYNC_T2) TCNT2 = t2_phase;
+
+    Timer_Sync_Release();
+
+    SREG = sreg;
+}
@@ -18,6 +18,7 @@
 #include "systick.h"          // Capa 1: Timer 0 (1ms)
 #include "timer1_normal.h"    // Capa 1: Timer 1 (16-bit Motor)
 #include "timer2_normal.h"    // Capa 1: Timer 2 (8-bit LED)
+#include "timer_sync.h"       // Capa 1: Arranque sincronizado (GTCCR)
 #include "exti.h"             // Capa 1: Eventos Externos
 
 #include "step_motor_28BYJ48.h" // Capa 2: Actuador
@@ -61,11 +62,24 @@
 
 /* --- 5. Parámetros de Temporización Crítica --- */
 
-/** * @brief Cálculo de velocidad del motor.
- * F_CPU = 16MHz, Prescaler = 64 -> 1 tick = 4us.
- * 625 ticks * 4us = 2.5ms por paso.
+/** * @brief Perfil de velocidad del motor (Timer 1, prescaler 64 -> 1 tick = 4us).
+ * El motor arranca a la velocidad de pull-in y acelera hasta la de crucero;
+ * sin rampa, el 28BYJ-48 pierde pasos por encima de ~400 pasos/s.
  */
-#define MOTOR_SPEED_DEFAULT   625  
+#define MOTOR_START_SPS       300   // Arranque: 3.3ms por paso
+#define MOTOR_MAX_SPS         800   // Crucero: 1.25ms por paso
+#define MOTOR_ACCEL_SPS2      1500  // Aceleración y frenado (pasos/s²)
+
+/** @brief Intervalo de sondeo con el motor detenido: 250 ticks * 4us = 1ms. */
+#define MOTOR_IDLE_POLL       250  
+
+/** * @brief Modo Hold (corriente reducida en reposo), servido por Timer 1 Canal B.
+ * 50 ticks * 4us = 200us -> chopper de 5kHz. Tras 500ms sin pasos la corriente
+ * de retención baja al 25% (64/256) sin perder la posición del eje.
+ */
+#define HOLD_SERVICE_TICKS    50
+#define HOLD_TIMEOUT_TICKS    2500  // 2500 * 200us = 500ms
+#define HOLD_DUTY             64    // 25% de la corriente nominal
 
 /** @brief Filtro de debounce para muestreo manual (20ms). */
 #define BUTTON_DEBOUNCE_TICKS 5000 
@@ -21,6 +21,9 @@
 // Intervalo de actualización del LCD (200ms para evitar flickering)
 #define T_REFRESH_LCD_MS   200  
 
+// Bytes de bus por pasada del volcado del framebuffer (acota el bloqueo de cada pasada)
+#define T_LCD_FLUSH_BYTES  2
+
 // Intervalo de parpadeo del LED de Sistema (250ms -> 2Hz)
 #define T_BLINK_SYS_MS     250  
 
@@ -38,6 +41,8 @@ void System_Init(void);
 
 /**
  * @brief Actualización de la interfaz visual en el LCD.
+ * @details Escribe sobre el framebuffer del driver: solo los caracteres que cambiaron
+ * quedan pendientes para el volcado incremental (@ref LCD_FB_Flush).
  * @param running Estado actual de marcha del motor.
  * @param dir Sentido de giro actual.
  */
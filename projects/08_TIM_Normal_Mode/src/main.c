@@ -9,6 +9,7 @@
 
 /* --- Instancias Globales (Capa 2) --- */
 Stepper_t motor_principal;
+Stepper_Ramp_t motor_ramp;
 LCD_Config_t lcd_main_cfg;
 
 /* --- Variables de Control (Capa 3) --- */
@@ -33,6 +34,9 @@ int main(void) {
             Task_Update_HMI(motor_running, motor_dir);
         }
 
+        /* TAREA: Volcado incremental del LCD (solo celdas modificadas, presupuesto fijo) */
+        LCD_FB_Flush(T_LCD_FLUSH_BYTES);
+
         /* TAREA: Latido de Sistema (Systick) */
         if (current_tick - last_led_toggle >= T_BLINK_SYS_MS){
             last_led_toggle = current_tick;
@@ -48,6 +52,8 @@ void System_Init(void) {
     volatile uint8_t* m_ports[] = {M1_IN1_PORT, M1_IN2_PORT, M1_IN3_PORT, M1_IN4_PORT};
     uint8_t m_pins[] = {M1_IN1_PIN, M1_IN2_PIN, M1_IN3_PIN, M1_IN4_PIN};
     Stepper_Init(&motor_principal, m_ports, m_pins, MODE_FULL_STEP);
+    Stepper_Ramp_Init(&motor_ramp, MOTOR_START_SPS, MOTOR_MAX_SPS, MOTOR_ACCEL_SPS2);
+    Stepper_Hold_Config(&motor_principal, HOLD_TIMEOUT_TICKS, HOLD_DUTY);
     
     /* 2. Configuración de Entradas y Salidas GPIO */
     GPIO_InitPin(GPIO_D, BTN_START_STOP, GPIO_INPUT);
@@ -74,17 +80,23 @@ void System_Init(void) {
     lcd_main_cfg.port_d7 = LCD_PORT_DIR.PORT; lcd_main_cfg.pin_d7 = LCD_D7_PIN;
     lcd_main_cfg.type    = LCD_16X2;
     LCD_Init(&lcd_main_cfg);
+    LCD_FB_Enable(true); // Las tareas escriben en SRAM; el volcado va por el scheduler
 
     /* 4. Configuración de Eventos Externos */
     EXTI_Init(EXTI_INT0, EXTI_FALLING_EDGE); 
     EXTI_Init(EXTI_INT1, EXTI_FALLING_EDGE); 
 
-    /* 5. Inicialización de Timers (Orquesta) */
+    /* 5. Inicialización de Timers (Orquesta)
+     * Los prescalers quedan retenidos mientras se configuran los tres Timers y se
+     * liberan juntos: la fase entre T0, T1 y T2 es la misma en cada arranque. */
+    Timer_Sync_Halt();
     Systick_Init(TIMER_0);                     // T0: Sistema
     Timer1_Normal_Init(T1_CLK_64, T1_OFF, T1_OFF); // T1: Motor
-    Timer1_Set_AlarmA(MOTOR_SPEED_DEFAULT);
+    Timer1_Set_AlarmA(MOTOR_IDLE_POLL);
+    Timer1_Set_AlarmB(HOLD_SERVICE_TICKS);         // T1B: Chopper del modo Hold
     Timer2_Normal_Init(T2_CLK_1024, T1_OFF, T1_OFF); // T2: Asíncrono
     Timer2_Enable_OVF_INT(); 
+    Timer_Sync_Release();
 
     sei(); // Habilitación global
 }
@@ -102,21 +114,35 @@ void Task_Update_HMI(bool running, Step_Dir_t dir) {
 
 ISR(INT0_vect) {
     motor_running = !motor_running;
+    if (!motor_running) Stepper_Ramp_Stop(&motor_ramp); // Frenado con rampa
 }
 
 ISR(INT1_vect) {
     motor_dir = (motor_dir == STEP_CW) ? STEP_CCW : STEP_CW;
+    /* La inversión exige detenerse: se frena y la ISR del motor re-arranca en el nuevo sentido */
+    Stepper_Ramp_Stop(&motor_ramp);
 }
 
 ISR(TIMER1_COMPA_vect) {
-    if (motor_running) {
+    uint16_t interval = MOTOR_IDLE_POLL;
+
+    if (Stepper_Ramp_IsRunning(&motor_ramp)) {
+        Stepper_Step_Sequential(&motor_principal);
+        interval = Stepper_Ramp_Tick(&motor_ramp);
+        if (interval == 0) interval = MOTOR_IDLE_POLL;
+    } else if (motor_running) {
+        /* Arranque (o re-arranque tras invertir): el sentido solo cambia con el motor detenido */
         motor_principal.is_active = true;
         motor_principal.direction = motor_dir;
-        Stepper_Step_Sequential(&motor_principal);
-    } else {
-        Stepper_Stop(&motor_principal);
+        Stepper_Ramp_Run(&motor_ramp);
     }
-    OCR1A += MOTOR_SPEED_DEFAULT;
+    /* Detenido: las bobinas quedan energizadas y el modo Hold reduce la corriente */
+    OCR1A += interval;
+}
+
+ISR(TIMER1_COMPB_vect) {
+    Stepper_Hold_Service(&motor_principal);
+    OCR1B += HOLD_SERVICE_TICKS;
 }
 
 ISR(TIMER2_OVF_vect) {
@@ -24,6 +24,10 @@
 #define LED_BREATH_CH     T2_PWM_CH_A   // PB3
 #define LED_PULSE_CH      T2_PWM_CH_B   // PD3
 
+/* --- Efecto Breathing (fundido por ISR de Overflow del Timer 2) --- */
+#define BREATH_HALF_MS    2550          // Duración de cada medio ciclo (subida o bajada)
+#define BREATH_CURVE      PWM_FADE_EXP  // Brillo percibido lineal
+
 /* --- Configuración de Systick --- */
 #define SYSTICK_TIMER     TIMER_0
 
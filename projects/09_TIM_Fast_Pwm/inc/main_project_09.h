@@ -17,9 +17,11 @@
 
 
 /**
- * @brief Tarea no bloqueante para el efecto breathing.
+ * @brief Arranca el efecto breathing.
+ * @details El fundido ida y vuelta corre íntegramente en la ISR de Overflow del
+ * Timer 2; el loop principal no vuelve a intervenir.
  */
-void task_breathing(void);
+void breathing_start(void);
 
 /**
  * @brief Tarea no bloqueante para el incremento de brillo por pulsador.
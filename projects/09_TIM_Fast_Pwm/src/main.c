@@ -34,25 +34,18 @@ int main(void) {
     
     sei(); 
 
+    breathing_start();
+
     while(1) {
-        task_breathing();
         task_button_led();
     }
 }
 
 /* --- Implementación de Tareas (Usando nombres del .h) --- */
 
-void task_breathing(void) {
-    static uint32_t last_tick = 0;
-    static uint8_t brillo = 0;
-    static int8_t paso = 1;
-    
-    if ((get_tick() - last_tick) >= 10) {
-        last_tick = get_tick();
-        brillo += paso;
-        if (brillo == 255 || brillo == 0) paso *= -1;
-        Timer2_PWM_Fast_SetDuty(LED_BREATH_CH, brillo);
-    }
+void breathing_start(void) {
+    Timer2_PWM_Fast_SetDuty(LED_BREATH_CH, 0);
+    Timer2_PWM_Fade(LED_BREATH_CH, 255, BREATH_HALF_MS, BREATH_CURVE, true);
 }
 
 void task_button_led(void) {
@@ -76,6 +69,10 @@ void task_button_led(void) {
 
 /* --- Rutinas de Servicio de Interrupción (ISR) --- */
 
+ISR(TIMER2_OVF_vect) {
+    Timer2_PWM_Fade_IRQHandler();
+}
+
 ISR(INT0_vect) {
     static uint32_t last_interrupt_time = 0;
     uint32_t current_time = get_tick();
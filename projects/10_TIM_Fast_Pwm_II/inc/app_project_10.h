@@ -24,11 +24,10 @@ void Sys_Init(void);
 
 /**
  * @brief Tarea de efecto visual Rainbow (Arcoíris).
- * @details Máquina de estados no bloqueante que recorre el círculo cromático.
- * @param interval Tiempo de espera entre transiciones en milisegundos.
- * @param step Cantidad de unidades (0-255) a incrementar/decrementar por paso.
+ * @details Avanza el tono HSV un paso por frame (no bloqueante).
+ * @param interval Tiempo entre pasos de tono en milisegundos.
  */
-void Task_Rainbow(uint32_t interval, uint8_t step);
+void Task_Rainbow(uint32_t interval);
 
 /**
  * @brief Tarea de latido de corazón (Heartbeat).
@@ -19,6 +19,8 @@
 #include "gpio.h"
 #include "timer0_fast_pwm.h"
 #include "timer2_fast_pwm.h"
+#include "pwm_channel.h"
+#include "timer_sync.h"
 
 /* --- 3. Mapeo Lógico de Hardware --- */
 
@@ -48,19 +50,22 @@
 #define LED_BTN_CH      T2_PWM_CH_B // Canal B del Timer 2 (OC2B)
 /**@}*/
 
-/* --- 4. Wrappers de Capa 1 (Abstracción de Hardware) --- */
-
-/**
- * @brief Wrappers estáticos para inyección de dependencias en el driver RGB.
- * @details Estas funciones adaptan la firma de los drivers de Timer 0 y 2
- * al formato esperado por el driver genérico de Capa 2 (rgb_led_driver.h).
- * El uso de 'static inline' elimina la sobrecarga de la llamada a función,
- * optimizando el rendimiento en tiempo de ejecución.
- * * @param d Duty cycle (0-255)
+/** @name Canales del LED RGB
+ * Registros OCR inyectados en el driver RGB (escritura directa, sin callbacks)
  */
-static inline void set_r_hw(uint8_t d) { Timer0_PWM_SetDuty(T0_PWM_CH_A, d); }
-static inline void set_g_hw(uint8_t d) { Timer0_PWM_SetDuty(T0_PWM_CH_B, d); }
-static inline void set_b_hw(uint8_t d) { Timer2_PWM_Fast_SetDuty(T2_PWM_CH_A, d); }
+/**@{*/
+#define LED_RGB_CH_R    PWM_CH_T0A  // OC0A - PD6
+#define LED_RGB_CH_G    PWM_CH_T0B  // OC0B - PD5
+#define LED_RGB_CH_B    PWM_CH_T2A  // OC2A - PB3
+/**@}*/
 
+/** @name Desfasaje de PWM
+ * Timer 0 (R, G) y Timer 2 (B) comparten prescaler (8): con el Timer 2 adelantado
+ * medio periodo, el flanco de subida del Azul no coincide con los de Rojo y Verde.
+ */
+/**@{*/
+#define LED_PWM_PHASE_T0   0
+#define LED_PWM_PHASE_T2   128
+/**@}*/
 
 #endif /* HW_PROJECT_10_H_ */
\ No newline at end of file
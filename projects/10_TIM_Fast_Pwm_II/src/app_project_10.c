@@ -24,17 +24,6 @@
  */
 static RGB_LED_t led_status;
 
-/** * @brief Estados de la máquina de estados para la transición cromática.
- */
-typedef enum {
-    RAINBOW_G_IN,   /**< Incremento de Verde (Rojo fijo) */
-    RAINBOW_R_OUT,  /**< Decremento de Rojo (Verde fijo) */
-    RAINBOW_B_IN,   /**< Incremento de Azul (Verde fijo) */
-    RAINBOW_G_OUT,  /**< Decremento de Verde (Azul fijo) */
-    RAINBOW_R_IN,   /**< Incremento de Rojo (Azul fijo) */
-    RAINBOW_B_OUT   /**< Decremento de Azul (Rojo fijo) */
-} rainbow_state_t;
-
 /** * @brief Bandera de señalización para el pulsador.
  * @details Declarada como 'volatile' para informar al compilador que su valor 
  * puede cambiar fuera del flujo normal del programa (dentro de una ISR).
@@ -52,18 +41,30 @@ void Sys_Init(void) {
     /* --- 1. Inicialización de Periféricos HAL (Capa 1) --- */
     
     // Timer 0: Generación de PWM para Rojo (OC0A) y Verde (OC0B)
-    Timer0_PWM_Init(T0_PWM_CLK_64);
+    // Prescaler 8 (7.8kHz): el ciclo de dithering de 16 periodos queda en 488Hz
+    Timer0_PWM_Init(T0_PWM_CLK_8);
     Timer0_PWM_EnableChannel(T0_PWM_CH_A, T0_PWM_NON_INVERTING);
     Timer0_PWM_EnableChannel(T0_PWM_CH_B, T0_PWM_NON_INVERTING);
 
     // Timer 2: Generación de PWM para Azul (OC2A) y LED de Usuario (OC2B)
-    Timer2_PWM_Fast_Init(T2_PWM_CLK_64);
+    Timer2_PWM_Fast_Init(T2_PWM_CLK_8);
     Timer2_PWM_Fast_EnableChannel(T2_PWM_CH_A, T2_PWM_NON_INVERTING);
 
+    // Alineación de fase: ambos Timers arrancan juntos, con el Timer 2 desfasado
+    // medio periodo (el Timer 1 del Systick conserva su cuenta)
+    Timer_Sync_Start(TIMER_SYNC_T0 | TIMER_SYNC_T2, LED_PWM_PHASE_T0, 0, LED_PWM_PHASE_T2);
+
     /* --- 2. Inicialización de Drivers de Dispositivo (Capa 2) --- */
     
-    // Inyección de dependencias: se pasan los wrappers de HW al driver RGB
-    RGB_Init(&led_status, RGB_ANODE_COMMON, 255, set_r_hw, set_g_hw, set_b_hw);
+    // Inyección de dependencias: se pasan los registros OCR al driver RGB
+    RGB_Init(&led_status, RGB_ANODE_COMMON, 255, LED_RGB_CH_R, LED_RGB_CH_G, LED_RGB_CH_B);
+
+    // Dithering temporal: 12 bits efectivos en el extremo oscuro del Arcoíris
+    RGB_Dither_Enable(&led_status, true);
+    Timer0_PWM_IT_Overflow(1);
+
+    // Color inicial del Arcoíris: Rojo puro (tono 0) a brillo completo
+    RGB_Set_HSV(&led_status, 0, 255, 255);
 
     /* --- 3. Configuración de Interfaces de Usuario (Capa 3) --- */
     
@@ -79,45 +80,19 @@ void Sys_Init(void) {
 }
 
 /**
- * @brief Tarea de actualización del efecto Arcoíris.
- * @param interval Tiempo en ms entre actualizaciones de color.
- * @param step Salto de intensidad (0-255) por cada iteración.
+ * @brief Tarea de efecto visual Rainbow (Arcoíris).
+ * @details Un paso de tono por frame. Dentro de un sector HSV el driver solo recalcula
+ * el canal que cambia, por lo que cada paso escribe un único OCR y no hace falta
+ * agrupar los tres canales en un commit.
+ * @param interval Tiempo entre pasos en milisegundos (6ms: una vuelta de 1536 pasos en 9.2s).
  */
-void Task_Rainbow(uint32_t interval, uint8_t step) {
+void Task_Rainbow(uint32_t interval) {
     static uint32_t last_tick = 0;
-    static rainbow_state_t state = RAINBOW_G_IN;
-    static uint8_t r = 255, g = 0, b = 0;
 
-    // Control de tiempo no bloqueante mediante Systick
     if ((get_tick() - last_tick) < interval) return;
     last_tick = get_tick();
 
-    uint8_t max = led_status.max_brightness;
-
-    /* Implementación de la transición cromática circular */
-    switch (state) {
-        case RAINBOW_G_IN:
-            if ((uint16_t)g + step >= max) { g = max; state = RAINBOW_R_OUT; } else g += step;
-            break;
-        case RAINBOW_R_OUT:
-            if (r <= step) { r = 0; state = RAINBOW_B_IN; } else r -= step;
-            break;
-        case RAINBOW_B_IN:
-            if ((uint16_t)b + step >= max) { b = max; state = RAINBOW_G_OUT; } else b += step;
-            break;
-        case RAINBOW_G_OUT:
-            if (g <= step) { g = 0; state = RAINBOW_R_IN; } else g -= step;
-            break;
-        case RAINBOW_R_IN:
-            if ((uint16_t)r + step >= max) { r = max; state = RAINBOW_B_OUT; } else r += step;
-            break;
-        case RAINBOW_B_OUT:
-            if (b <= step) { b = 0; state = RAINBOW_G_IN; } else b -= step;
-            break;
-    }
-
-    // Actualización del hardware a través del driver genérico
-    RGB_Set_Color_Direct(&led_status, r, g, b);
+    RGB_Hue_Step(&led_status, 1);
 }
 
 /**
@@ -161,6 +136,15 @@ void task_button_led(void) {
 
 /* --- 3. Rutinas de Servicio de Interrupción (ISR) --- */
 
+/**
+ * @brief ISR de Overflow del Timer 0: dithering temporal del LED RGB.
+ * @details El handler es inline y no hay llamadas: la ISR solo guarda los registros que
+ * usa (~130 ciclos por periodo, estimado). El tono avanza en @ref Task_Rainbow.
+ */
+ISR(TIMER0_OVF_vect) {
+    RGB_Dither_IRQHandler(&led_status);
+}
+
 /**
  * @brief ISR para Interrupción Externa 0 (INT0).
  * @details Detecta la pulsación y aplica un filtro de rebotes (Debouncing) 
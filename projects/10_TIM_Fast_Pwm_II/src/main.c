@@ -26,7 +26,7 @@ int main(void) {
 
     while (1) {
         /* Ejecución de Tareas Cooperativas */
-        Task_Rainbow(30, 5);    //Tarea del LED RGB
+        Task_Rainbow(6);        //Tarea del LED RGB (un paso de tono)
         Task_Toggle(100);       //Tarea del Toggle con Systick
         task_button_led();      //Tarea del dimer PD3 con boton en PD2
     }
@@ -3,19 +3,19 @@
 
 #include <avr/io.h>
 #include "timer1_fast_pwm.h"
+#include "pwm_channel.h"
 
 /* Definiciones de Hardware */
 #define SERVO_FREQ_TOP      39999 
 #define SG90_MIN_TICKS      1000  
 #define SG90_MAX_TICKS      5500  
 
-/* Wrappers: Adaptan la Capa 1 a la Capa 2 */
-static inline void hw_servo_A_write(uint16_t ticks) {
-    Timer1_PWM_Fast_SetCompare(T1_PWM_CH_A, ticks);
-}
+/* Perfil de movimiento del barrido */
+#define SWEEP_SPEED_DPS     120   /* Velocidad de crucero (°/s) */
+#define SWEEP_ACCEL_DPS2    400   /* Aceleración y frenado (°/s²) */
 
-static inline void hw_servo_B_write(uint16_t ticks) {
-    Timer1_PWM_Fast_SetCompare(T1_PWM_CH_B, ticks);
-}
+/* Canales PWM: la Capa 2 escribe directo sobre OCR1A/OCR1B */
+#define SERVO_1_CH          PWM_CH_T1A    /* PB1 */
+#define SERVO_2_CH          PWM_CH_T1B    /* PB2 */
 
 #endif
\ No newline at end of file
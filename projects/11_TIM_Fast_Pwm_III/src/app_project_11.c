@@ -1,17 +1,14 @@
 #include "app_project_11.h"
 #include "hw_project_11.h"
 #include "servo_sg90.h"
-#include "systick.h"
 #include <avr/interrupt.h>
 
 /* Instancias privadas de los servos */
 static Servo_t servo1;
 static Servo_t servo2;
 
-/* Variables de estado del movimiento */
-static uint8_t  angle = 0;
-static int8_t   step  = 1;
-static uint32_t last_tick = 0;
+/* Extremo hacia el que se dirige el servo 1 (el servo 2 va en espejo) */
+static uint16_t target = SERVO_DECIDEG_MAX;
 
 void App_Init(void) {
     /* 1. Hardware PWM */
@@ -20,29 +17,30 @@ void App_Init(void) {
     Timer1_PWM_Fast_EnableChannel(T1_PWM_CH_B, T1_PWM_NON_INVERTING);
 
     /* 2. Drivers de Dispositivo (Inyección) */
-    Servo_Init(&servo1,  SG90_MIN_TICKS, SG90_MAX_TICKS, hw_servo_A_write);
-    Servo_Init(&servo2, SG90_MIN_TICKS, SG90_MAX_TICKS, hw_servo_B_write);
+    Servo_Init(&servo1, SG90_MIN_TICKS, SG90_MAX_TICKS, SERVO_1_CH);
+    Servo_Init(&servo2, SG90_MIN_TICKS, SG90_MAX_TICKS, SERVO_2_CH);
 
     /* 3. Posicionamiento inicial seguro */
     Servo_SetAngle(&servo1, 0);
     Servo_SetAngle(&servo2, 180);
 
-    /* 4. Base de tiempo */
-    Systick_Init(TIMER_0);
-    //last_tick = get_tick();
+    /* 4. Base de tiempo del perfilador: overflow del Timer 1 (1 por frame de 20ms) */
+    Timer1_PWM_IT_Overflow(1);
 }
 
 void App_Task_ServoSweep(void) {
-    if (get_tick() - last_tick >= 30) {
-        last_tick = get_tick();
-
-        // Lógica de rebote
-        if (angle >= 180) step = -1;
-        if (angle <= 0)   step = 1;
-        angle += step;
-
-        // Actualización de servos
-        Servo_SetAngle(&servo1,  angle);
-        Servo_SetAngle(&servo2, 180 - angle); // Espejo
-    }
-}
\ No newline at end of file
+    /* La trayectoria corre en la ISR; la tarea solo emite el siguiente objetivo */
+    if (Servo_IsMoving(&servo1) || Servo_IsMoving(&servo2)) return;
+
+    // Lógica de rebote
+    target = (target == 0) ? SERVO_DECIDEG_MAX : 0;
+
+    Servo_MoveTo(&servo1, target, SERVO_VEL_DPS(SWEEP_SPEED_DPS), SERVO_ACC_DPS2(SWEEP_ACCEL_DPS2));
+    Servo_MoveTo(&servo2, SERVO_DECIDEG_MAX - target, SERVO_VEL_DPS(SWEEP_SPEED_DPS), SERVO_ACC_DPS2(SWEEP_ACCEL_DPS2)); // Espejo
+}
+
+/* --- Manejadores de Interrupción --- */
+
+ISR(TIMER1_OVF_vect) {
+    Servo_Motion_Update();
+}